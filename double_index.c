@@ -0,0 +1,564 @@
+/*******************************************************************************
+* double_index.c: Innehller funktioner fr implementering av hashindex som
+*                 mappar flyttal till noder via strukten double_index.
+*******************************************************************************/
+#include "double_list.h"
+#include <stdint.h>
+#include <string.h>
+
+/* Makrodefinitioner: */
+#define DOUBLE_INDEX_MIN_CAPACITY 16 /* Minsta antalet platser i tabellen. */
+#define DOUBLE_INDEX_EMPTY 0         /* Platsen har aldrig anvnts. */
+#define DOUBLE_INDEX_USED 1          /* Platsen lagrar ett flyttal. */
+#define DOUBLE_INDEX_REMOVED 2       /* Platsen har tmts (gravsten). */
+
+/* Statiska funktioner: */
+static size_t double_index_hash(const double val);
+static struct double_node** double_index_slot_at(struct double_index_slot* slot,
+                                                 const size_t position);
+static struct double_index_slot* double_index_slot_of(const struct double_index* self,
+                                                      const struct double_node* node,
+                                                      const size_t position);
+static struct double_index_slot* double_index_lookup(const struct double_index* self,
+                                                     const double key);
+static int double_index_rehash(struct double_index* self,
+                               const size_t new_capacity);
+static int double_index_reserve(struct double_index* self);
+static size_t double_index_entry_hash(const struct double_node* node);
+static struct double_index_entry* double_index_entry_lookup(const struct double_index* self,
+                                                            const struct double_node* node);
+static int double_index_entry_reserve(struct double_index* self);
+static void double_index_entry_insert(struct double_index* self,
+                                      const struct double_node* node,
+                                      const size_t position);
+static void double_index_entry_erase(struct double_index* self,
+                                     struct double_index_entry* entry);
+
+/*******************************************************************************
+* double_index_ptr_new: Allokerar minne fr ett nytt tomt hashindex.
+*                       Vid misslyckad minnesallokering returneras null.
+*******************************************************************************/
+struct double_index* double_index_ptr_new(void)
+{
+   struct double_index* self = (struct double_index*)malloc(sizeof(struct double_index));
+   if (!self) return 0;
+
+   self->slots = (struct double_index_slot*)calloc(DOUBLE_INDEX_MIN_CAPACITY,
+                                                   sizeof(struct double_index_slot));
+   self->entries = (struct double_index_entry*)calloc(DOUBLE_INDEX_MIN_CAPACITY,
+                                                      sizeof(struct double_index_entry));
+   if (!self->slots || !self->entries)
+   {
+      free(self->slots);
+      free(self->entries);
+      free(self);
+      return 0;
+   }
+
+   self->capacity = DOUBLE_INDEX_MIN_CAPACITY;
+   self->used = 0;
+   self->size = 0;
+   self->entry_capacity = DOUBLE_INDEX_MIN_CAPACITY;
+   self->next = 0;
+   return self;
+}
+
+/*******************************************************************************
+* double_index_ptr_delete: Frigr minne allokerat fr angivet hashindex och
+*                          stter pekaren till indexet till null. Noderna som
+*                          indexet refererar till pverkas inte.
+*
+*                          - self: Adressen till den pekare som pekar p
+*                                  hashindexet.
+*******************************************************************************/
+void double_index_ptr_delete(struct double_index** self)
+{
+   if (!*self) return;
+
+   for (size_t i = 0; i < (*self)->capacity; ++i)
+   {
+      free((*self)->slots[i].nodes);
+   }
+
+   free((*self)->slots);
+   free((*self)->entries);
+   free(*self);
+   *self = 0;
+   return;
+}
+
+/*******************************************************************************
+* double_index_clear: Tar bort samtliga noder ur angivet hashindex. Tabellernas
+*                     storlek behlls fr efterfljande insttningar.
+*
+*                     - self: Pekare till hashindexet.
+*******************************************************************************/
+void double_index_clear(struct double_index* self)
+{
+   for (size_t i = 0; i < self->capacity; ++i)
+   {
+      free(self->slots[i].nodes);
+   }
+
+   memset(self->slots, 0, sizeof(struct double_index_slot) * self->capacity);
+   memset(self->entries, 0, sizeof(struct double_index_entry) * self->entry_capacity);
+   self->used = 0;
+   self->size = 0;
+   return;
+}
+
+/*******************************************************************************
+* double_index_insert: Lgger till angiven nod i hashindexet under det flyttal
+*                      som noden lagrar. Vid misslyckad minnesallokering
+*                      returneras 1, annars 0.
+*
+*                      - self: Pekare till hashindexet.
+*                      - node: Pekare till den nod som skall indexeras.
+*******************************************************************************/
+int double_index_insert(struct double_index* self,
+                        struct double_node* node)
+{
+   struct double_index_slot* slot = 0;
+   if (double_index_entry_reserve(self)) return 1;
+   slot = double_index_lookup(self, node->data);
+
+   if (!slot)
+   {
+      if (double_index_reserve(self)) return 1;
+      size_t i = double_index_hash(node->data) & (self->capacity - 1);
+
+      while (self->slots[i].state == DOUBLE_INDEX_USED)
+      {
+         i = (i + 1) & (self->capacity - 1);
+      }
+
+      slot = &self->slots[i];
+      if (slot->state == DOUBLE_INDEX_EMPTY) self->used++;
+      slot->key = node->data;
+      slot->node = 0;
+      slot->nodes = 0;
+      slot->count = 0;
+      slot->capacity = 0;
+      slot->state = DOUBLE_INDEX_USED;
+   }
+
+   if (slot->count && slot->count - 1 == slot->capacity)
+   {
+      const size_t new_capacity = slot->capacity ? slot->capacity * 2 : 1;
+      struct double_node** copy = (struct double_node**)realloc(slot->nodes,
+                                  sizeof(struct double_node*) * new_capacity);
+      if (!copy) return 1;
+      slot->nodes = copy;
+      slot->capacity = new_capacity;
+   }
+
+   *double_index_slot_at(slot, slot->count) = node;
+   double_index_entry_insert(self, node, slot->count);
+   slot->count++;
+   self->size++;
+   return 0;
+}
+
+/*******************************************************************************
+* double_index_remove: Tar bort angiven nod ur hashindexet i konstant tid.
+*                      Nodens plats sks under det flyttal noden fr
+*                      tillfllet lagrar. Ifall nodens vrde har ndrats
+*                      direkt via fltet data efter indexeringen sks i
+*                      stllet samtliga platser igenom, vilket sker i
+*                      linjr tid. Ifall noden inte r indexerad sker ingen
+*                      frndring.
+*
+*                      - self: Pekare till hashindexet.
+*                      - node: Pekare till den nod som skall tas bort.
+*******************************************************************************/
+void double_index_remove(struct double_index* self,
+                         const struct double_node* node)
+{
+   struct double_index_entry* entry = double_index_entry_lookup(self, node);
+   struct double_index_slot* slot = 0;
+   struct double_node* last = 0;
+   size_t position = 0;
+
+   if (!entry) return;
+   position = entry->position;
+   slot = double_index_slot_of(self, node, position);
+   if (!slot) return;
+
+   last = *double_index_slot_at(slot, --slot->count);
+   *double_index_slot_at(slot, position) = last;
+
+   if (last != node)
+   {
+      double_index_entry_lookup(self, last)->position = position;
+   }
+
+   double_index_entry_erase(self, entry);
+   self->size--;
+
+   if (!slot->count)
+   {
+      free(slot->nodes);
+      slot->node = 0;
+      slot->nodes = 0;
+      slot->capacity = 0;
+      slot->state = DOUBLE_INDEX_REMOVED;
+   }
+   return;
+}
+
+/*******************************************************************************
+* double_index_find: Returnerar adressen till en nod som lagrar angivet
+*                    flyttal. Ifall flera noder lagrar flyttalet r det
+*                    odefinierat vilken av dem som returneras. Ifall ingen
+*                    nod lagrar flyttalet returneras null.
+*
+*                    - self: Pekare till hashindexet.
+*                    - val : Det flyttal som skall skas efter.
+*******************************************************************************/
+struct double_node* double_index_find(const struct double_index* self,
+                                      const double val)
+{
+   const struct double_index_slot* slot = double_index_lookup(self, val);
+   return slot ? slot->node : 0;
+}
+
+/*******************************************************************************
+* double_index_contains: Indikerar ifall just angiven nod r indexerad under
+*                        det flyttal den lagrar, till skillnad frn
+*                        double_index_find som endast visar att ngon nod
+*                        med samma vrde r indexerad.
+*
+*                        - self: Pekare till hashindexet.
+*                        - node: Pekare till noden som sks.
+*******************************************************************************/
+int double_index_contains(const struct double_index* self,
+                          const struct double_node* node)
+{
+   const struct double_index_entry* entry = double_index_entry_lookup(self, node);
+   struct double_index_slot* slot = double_index_lookup(self, node->data);
+
+   return entry && slot && entry->position < slot->count &&
+          *double_index_slot_at(slot, entry->position) == node;
+}
+
+/*******************************************************************************
+* double_index_equal: Indikerar ifall tv flyttal betraktas som lika vid
+*                     skning. Till skillnad frn operatorn == betraktas
+*                     samtliga NaN-vrden som lika, medan +0 och -0
+*                     fortfarande betraktas som lika.
+*
+*                     - x: Det frsta flyttalet.
+*                     - y: Det andra flyttalet.
+*******************************************************************************/
+int double_index_equal(const double x,
+                       const double y)
+{
+   return x == y || (x != x && y != y);
+}
+
+/*******************************************************************************
+* double_index_hash: Returnerar hashvrdet fr angivet flyttal baserat p
+*                    dess bitmnster. Samtliga NaN-vrden samt +0 och -0
+*                    normaliseras innan hashning, s att flyttal som betraktas
+*                    som lika av double_index_equal erhller samma hashvrde.
+*
+*                    - val: Det flyttal som skall hashas.
+*******************************************************************************/
+static size_t double_index_hash(const double val)
+{
+   uint64_t bits = 0;
+
+   if (val != val)
+   {
+      bits = UINT64_C(0x7ff8000000000000);
+   }
+   else if (val != 0)
+   {
+      memcpy(&bits, &val, sizeof(bits));
+   }
+
+   bits ^= bits >> 33;
+   bits *= UINT64_C(0xff51afd7ed558ccd);
+   bits ^= bits >> 33;
+   bits *= UINT64_C(0xc4ceb9fe1a85ec53);
+   bits ^= bits >> 33;
+   return (size_t)bits;
+}
+
+/*******************************************************************************
+* double_index_slot_at: Returnerar adressen till nodpekaren p angiven position
+*                       i angiven plats, dr position 0 avser den nod som
+*                       lagras direkt i platsen.
+*
+*                       - slot    : Pekare till platsen.
+*                       - position: Nodens position bland platsens noder.
+*******************************************************************************/
+static struct double_node** double_index_slot_at(struct double_index_slot* slot,
+                                                 const size_t position)
+{
+   return position ? &slot->nodes[position - 1] : &slot->node;
+}
+
+/*******************************************************************************
+* double_index_slot_of: Returnerar adressen till den plats som lagrar angiven
+*                       nod p angiven position. Platsen sks frst under det
+*                       flyttal noden lagrar. Ifall noden inte finns dr (fr
+*                       att dess vrde har ndrats direkt via fltet data)
+*                       sks samtliga platser igenom. Ifall noden inte hittas
+*                       returneras null.
+*
+*                       - self    : Pekare till hashindexet.
+*                       - node    : Pekare till noden.
+*                       - position: Nodens position enligt nodtabellen.
+*******************************************************************************/
+static struct double_index_slot* double_index_slot_of(const struct double_index* self,
+                                                      const struct double_node* node,
+                                                      const size_t position)
+{
+   struct double_index_slot* slot = double_index_lookup(self, node->data);
+
+   if (slot && position < slot->count && *double_index_slot_at(slot, position) == node)
+   {
+      return slot;
+   }
+
+   for (size_t i = 0; i < self->capacity; ++i)
+   {
+      slot = &self->slots[i];
+
+      if (slot->state == DOUBLE_INDEX_USED && position < slot->count &&
+          *double_index_slot_at(slot, position) == node)
+      {
+         return slot;
+      }
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+* double_index_lookup: Returnerar adressen till den upptagna plats som lagrar
+*                      angivet flyttal. Ifall ingen sdan plats finns
+*                      returneras null.
+*
+*                      - self: Pekare till hashindexet.
+*                      - key : Det flyttal som skall skas efter.
+*******************************************************************************/
+static struct double_index_slot* double_index_lookup(const struct double_index* self,
+                                                     const double key)
+{
+   size_t i = double_index_hash(key) & (self->capacity - 1);
+
+   while (self->slots[i].state != DOUBLE_INDEX_EMPTY)
+   {
+      struct double_index_slot* slot = &self->slots[i];
+
+      if (slot->state == DOUBLE_INDEX_USED && double_index_equal(slot->key, key))
+      {
+         return slot;
+      }
+
+      i = (i + 1) & (self->capacity - 1);
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+* double_index_rehash: Flyttar samtliga upptagna platser till en ny tabell med
+*                      angivet antal platser, vilket ven rensar bort gravstenar.
+*                      Vid misslyckad minnesallokering returneras 1, annars 0.
+*
+*                      - self        : Pekare till hashindexet.
+*                      - new_capacity: Nytt antal platser (en tvpotens).
+*******************************************************************************/
+static int double_index_rehash(struct double_index* self,
+                               const size_t new_capacity)
+{
+   struct double_index_slot* slots = (struct double_index_slot*)calloc(new_capacity,
+                                     sizeof(struct double_index_slot));
+   if (!slots) return 1;
+
+   self->used = 0;
+
+   for (size_t i = 0; i < self->capacity; ++i)
+   {
+      if (self->slots[i].state == DOUBLE_INDEX_USED)
+      {
+         size_t j = double_index_hash(self->slots[i].key) & (new_capacity - 1);
+
+         while (slots[j].state != DOUBLE_INDEX_EMPTY)
+         {
+            j = (j + 1) & (new_capacity - 1);
+         }
+
+         slots[j] = self->slots[i];
+         self->used++;
+      }
+   }
+
+   free(self->slots);
+   self->slots = slots;
+   self->capacity = new_capacity;
+   return 0;
+}
+
+/*******************************************************************************
+* double_index_reserve: Skerstller att det finns utrymme fr ytterligare en
+*                       upptagen plats, s att fyllnadsgraden (inklusive
+*                       gravstenar) aldrig verstiger 75 %. Vid behov dubblas
+*                       antalet platser, annars rensas gravstenar bort.
+*
+*                       - self: Pekare till hashindexet.
+*******************************************************************************/
+static int double_index_reserve(struct double_index* self)
+{
+   if ((self->used + 1) * 4 <= self->capacity * 3) return 0;
+   size_t occupied = 0;
+
+   for (size_t i = 0; i < self->capacity; ++i)
+   {
+      if (self->slots[i].state == DOUBLE_INDEX_USED) occupied++;
+   }
+
+   if ((occupied + 1) * 2 > self->capacity)
+   {
+      return double_index_rehash(self, self->capacity * 2);
+   }
+   else
+   {
+      return double_index_rehash(self, self->capacity);
+   }
+}
+
+/*******************************************************************************
+* double_index_entry_hash: Returnerar hashvrdet fr angiven nodadress.
+*
+*                          - node: Nodens adress.
+*******************************************************************************/
+static size_t double_index_entry_hash(const struct double_node* node)
+{
+   uint64_t bits = (uint64_t)(uintptr_t)node;
+   bits ^= bits >> 33;
+   bits *= UINT64_C(0xff51afd7ed558ccd);
+   bits ^= bits >> 33;
+   return (size_t)bits;
+}
+
+/*******************************************************************************
+* double_index_entry_lookup: Returnerar adressen till posten fr angiven nod
+*                            i nodtabellen. Ifall noden saknas returneras null.
+*
+*                            - self: Pekare till hashindexet.
+*                            - node: Nodens adress.
+*******************************************************************************/
+static struct double_index_entry* double_index_entry_lookup(const struct double_index* self,
+                                                            const struct double_node* node)
+{
+   const size_t mask = self->entry_capacity - 1;
+   size_t i = double_index_entry_hash(node) & mask;
+
+   while (self->entries[i].node)
+   {
+      if (self->entries[i].node == node) return &self->entries[i];
+      i = (i + 1) & mask;
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+* double_index_entry_reserve: Skerstller att nodtabellen rymmer ytterligare
+*                             en post utan att fyllnadsgraden verstiger 75 %.
+*                             Vid behov dubblas antalet poster. Vid misslyckad
+*                             minnesallokering returneras 1, annars 0.
+*
+*                             - self: Pekare till hashindexet.
+*******************************************************************************/
+static int double_index_entry_reserve(struct double_index* self)
+{
+   struct double_index_entry* old_entries = self->entries;
+   const size_t old_capacity = self->entry_capacity;
+
+   if ((self->size + 1) * 4 <= self->entry_capacity * 3) return 0;
+
+   self->entries = (struct double_index_entry*)calloc(old_capacity * 2,
+                                                      sizeof(struct double_index_entry));
+   if (!self->entries)
+   {
+      self->entries = old_entries;
+      return 1;
+   }
+
+   self->entry_capacity = old_capacity * 2;
+
+   for (size_t i = 0; i < old_capacity; ++i)
+   {
+      if (old_entries[i].node)
+      {
+         double_index_entry_insert(self, old_entries[i].node, old_entries[i].position);
+      }
+   }
+
+   free(old_entries);
+   return 0;
+}
+
+/*******************************************************************************
+* double_index_entry_insert: Lgger till en post fr angiven nod i nodtabellen.
+*                            Utrymme mste frst ha reserverats via
+*                            double_index_entry_reserve.
+*
+*                            - self    : Pekare till hashindexet.
+*                            - node    : Nodens adress.
+*                            - position: Nodens position bland platsens noder.
+*******************************************************************************/
+static void double_index_entry_insert(struct double_index* self,
+                                      const struct double_node* node,
+                                      const size_t position)
+{
+   const size_t mask = self->entry_capacity - 1;
+   size_t i = double_index_entry_hash(node) & mask;
+
+   while (self->entries[i].node)
+   {
+      i = (i + 1) & mask;
+   }
+
+   self->entries[i].node = node;
+   self->entries[i].position = position;
+   return;
+}
+
+/*******************************************************************************
+* double_index_entry_erase: Tar bort angiven post ur nodtabellen. Efterfljande
+*                           poster i samma sonderingskedja flyttas bakt, s
+*                           att tabellen aldrig innehller gravstenar.
+*
+*                           - self : Pekare till hashindexet.
+*                           - entry: Pekare till posten som skall tas bort.
+*******************************************************************************/
+static void double_index_entry_erase(struct double_index* self,
+                                     struct double_index_entry* entry)
+{
+   const size_t mask = self->entry_capacity - 1;
+   size_t i = (size_t)(entry - self->entries);
+   size_t j = i;
+
+   while (1)
+   {
+      size_t home = 0;
+      j = (j + 1) & mask;
+      if (!self->entries[j].node) break;
+      home = double_index_entry_hash(self->entries[j].node) & mask;
+
+      if ((i <= j) ? (home <= i || home > j) : (home <= i && home > j))
+      {
+         self->entries[i] = self->entries[j];
+         i = j;
+      }
+   }
+
+   self->entries[i].node = 0;
+   return;
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*******************************************************************************
+* double_index.h: Innehller funktionalitet fr ett hashindex som mappar lagrade
+*                 flyttal till noder i dubbellnkade listor av strukten
+*                 double_list, vilket mjliggr skning i konstant tid.
+*******************************************************************************/
+#ifndef DOUBLE_INDEX_H_
+#define DOUBLE_INDEX_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+
+struct double_node;
+
+/*******************************************************************************
+* double_index_slot: Plats i hashtabellen fr ett index av strukten
+*                    double_index. Varje upptagen plats lagrar ett unikt
+*                    flyttal samt adresserna till samtliga noder som lagrar
+*                    detta flyttal, vilket medfr att dubbletter hanteras.
+*                    Den frsta noden lagras direkt i platsen, s att unika
+*                    flyttal inte krver ngon separat allokering.
+*******************************************************************************/
+struct double_index_slot
+{
+   double key;                 /* Det flyttal som platsen avser. */
+   struct double_node* node;   /* Frsta noden som lagrar flyttalet. */
+   struct double_node** nodes; /* vriga noder som lagrar flyttalet. */
+   size_t count;               /* Antalet noder som lagrar flyttalet. */
+   size_t capacity;            /* Kapaciteten fr vriga nodpekare. */
+   int state;                  /* Tom (0), upptagen (1) eller raderad (2). */
+};
+
+/*******************************************************************************
+* double_index_entry: Post i indexets nodtabell, som mappar en nods adress
+*                     till nodens position bland sin plats noder. Detta
+*                     medfr att en nod kan tas bort i konstant tid ven nr
+*                     mnga noder lagrar samma flyttal.
+*******************************************************************************/
+struct double_index_entry
+{
+   const struct double_node* node; /* Nodens adress (null fr tom post). */
+   size_t position;                /* Nodens position bland platsens noder. */
+};
+
+/*******************************************************************************
+* double_index: Implementering av ett hashindex med ppen adressering, dr
+*               kollisioner hanteras via linjr sondering. Flyttal jmfrs
+*               via sitt vrde, dr +0 och -0 betraktas som lika, liksom
+*               samtliga NaN-vrden. En separat nodtabell (ven den med
+*               linjr sondering) mappar varje nods adress till dess
+*               position, s att borttagning inte krver ngon skning.
+*******************************************************************************/
+struct double_index
+{
+   struct double_index_slot* slots;    /* Hashtabellens platser. */
+   size_t capacity;                    /* Antalet platser (alltid en tvpotens). */
+   size_t used;                        /* Antalet upptagna samt raderade platser. */
+   size_t size;                        /* Antalet indexerade noder. */
+   struct double_index_entry* entries; /* Nodtabellens poster. */
+   size_t entry_capacity;              /* Antalet poster (alltid en tvpotens). */
+   struct double_index* next;          /* Nsta index i kn fr frdrjd frigrelse. */
+};
+
+/* Externa funktioner: */
+struct double_index* double_index_ptr_new(void);
+void double_index_ptr_delete(struct double_index** self);
+void double_index_clear(struct double_index* self);
+int double_index_insert(struct double_index* self,
+                        struct double_node* node);
+void double_index_remove(struct double_index* self,
+                         const struct double_node* node);
+struct double_node* double_index_find(const struct double_index* self,
+                                      const double val);
+int double_index_contains(const struct double_index* self,
+                          const struct double_node* node);
+int double_index_equal(const double x,
+                       const double y);
+
+#endif /* DOUBLE_INDEX_H_ */
\ No newline at end of file
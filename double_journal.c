@@ -0,0 +1,450 @@
+/*******************************************************************************
+* double_journal.c: Innehller funktioner fr implementering av ndringsloggar
+*                   fr dubbellnkade listor via strukten double_journal.
+*******************************************************************************/
+#include "double_journal.h"
+#include "double_list.h"
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+* double_journal_op: Avkodad operation ur en ndringslogg.
+*******************************************************************************/
+struct double_journal_op
+{
+   unsigned char op; /* Operationskod. */
+   size_t index;     /* Index som operationen avser (om relevant). */
+   double val;       /* Flyttal som operationen lagrar (om relevant). */
+};
+
+/* Statiska funktioner: */
+static int double_journal_reserve(struct double_journal* self,
+                                  const size_t size);
+static int double_journal_has_index(const unsigned char op);
+static int double_journal_has_value(const unsigned char op);
+static int double_journal_decode(const struct double_journal* self,
+                                 size_t* pos,
+                                 struct double_journal_op* op);
+
+/*******************************************************************************
+* double_journal_new: Initierar tom ndringslogg.
+*
+*                     - self: Pekare till den ndringslogg som skall initieras.
+*******************************************************************************/
+void double_journal_new(struct double_journal* self)
+{
+   self->data = 0;
+   self->size = 0;
+   self->capacity = 0;
+   self->error = 0;
+   return;
+}
+
+/*******************************************************************************
+* double_journal_delete: Frigr minne allokerat fr angiven ndringslogg och
+*                        nollstller loggens parametrar. Loggen mste frst
+*                        kopplas bort frn eventuella listor.
+*
+*                        - self: Pekare till ndringsloggen.
+*******************************************************************************/
+void double_journal_delete(struct double_journal* self)
+{
+   free(self->data);
+   double_journal_new(self);
+   return;
+}
+
+/*******************************************************************************
+* double_journal_clear: Tmmer angiven ndringslogg, exempelvis efter att
+*                       innehllet har skickats till en kopia. Allokerat minne
+*                       behlls fr efterfljande operationer.
+*
+*                       - self: Pekare till ndringsloggen.
+*******************************************************************************/
+void double_journal_clear(struct double_journal* self)
+{
+   self->size = 0;
+   self->error = 0;
+   return;
+}
+
+/*******************************************************************************
+* double_journal_log: Lgger till en operation sist i angiven ndringslogg.
+*                     Index respektive flyttal lagras endast fr operationer
+*                     som anvnder dem. Vid misslyckad minnesallokering
+*                     returneras 1 och loggens felflagga stts, vilket
+*                     innebr att kopior mste synkroniseras om i sin helhet.
+*
+*                     - self : Pekare till ndringsloggen.
+*                     - op   : Operationskod (DOUBLE_JOURNAL_*).
+*                     - index: Index som operationen avser.
+*                     - val  : Flyttal som operationen lagrar.
+*******************************************************************************/
+int double_journal_log(struct double_journal* self,
+                       const unsigned char op,
+                       const size_t index,
+                       const double val)
+{
+   if (double_journal_reserve(self, 1 + 10 + 8))
+   {
+      self->error = 1;
+      return 1;
+   }
+
+   self->data[self->size++] = op;
+
+   if (double_journal_has_index(op))
+   {
+      size_t num = index;
+
+      while (num >= 0x80)
+      {
+         self->data[self->size++] = (unsigned char)(num | 0x80);
+         num >>= 7;
+      }
+
+      self->data[self->size++] = (unsigned char)num;
+   }
+
+   if (double_journal_has_value(op))
+   {
+      uint64_t bits = 0;
+      memcpy(&bits, &val, sizeof(bits));
+
+      for (int i = 0; i < 8; ++i)
+      {
+         self->data[self->size++] = (unsigned char)(bits >> (8 * i));
+      }
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+* double_journal_apply: Spelar upp samtliga operationer i angiven ndringslogg
+*                       p angiven lnkad lista. Ifall loggen r felaktig,
+*                       en operation inte kan genomfras (exempelvis
+*                       borttagning ur en tom lista, vilket innebr att
+*                       kopian har avvikit frn originalet) eller listan
+*                       skriver till samma logg returneras 1, annars 0.
+*                       Vid fel kan listan ha uppdaterats delvis.
+*
+*                       - self: Pekare till ndringsloggen.
+*                       - list: Pekare till den lnkade lista som skall
+*                               uppdateras.
+*******************************************************************************/
+int double_journal_apply(const struct double_journal* self,
+                         struct double_list* list)
+{
+   size_t pos = 0;
+   if (list->journal == self) return 1;
+
+   while (pos < self->size)
+   {
+      struct double_journal_op op;
+      if (double_journal_decode(self, &pos, &op)) return 1;
+
+      if (op.op == DOUBLE_JOURNAL_PUSH_FRONT)
+      {
+         if (double_list_push_front(list, op.val)) return 1;
+      }
+      else if (op.op == DOUBLE_JOURNAL_PUSH_BACK)
+      {
+         if (double_list_push_back(list, op.val)) return 1;
+      }
+      else if (op.op == DOUBLE_JOURNAL_POP_FRONT)
+      {
+         if (!list->size) return 1;
+         double_list_pop_front(list);
+      }
+      else if (op.op == DOUBLE_JOURNAL_POP_BACK)
+      {
+         if (!list->size) return 1;
+         double_list_pop_back(list);
+      }
+      else if (op.op == DOUBLE_JOURNAL_INSERT)
+      {
+         if (double_list_insert_at_index(list, op.index, op.val)) return 1;
+      }
+      else if (op.op == DOUBLE_JOURNAL_REMOVE)
+      {
+         struct double_node* node = double_list_node_at(list, op.index);
+         if (!node) return 1;
+         double_list_remove_at_address(list, node);
+      }
+      else if (op.op == DOUBLE_JOURNAL_ASSIGN)
+      {
+         if (op.index >= list->size) return 1;
+         double_list_assign_at_index(list, op.index, op.val);
+      }
+      else
+      {
+         double_list_clear(list);
+      }
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+* double_journal_compact: Komprimerar angiven ndringslogg genom att ta bort
+*                         operationer som saknar effekt p slutresultatet.
+*                         Samtliga operationer fre den sista tmningen tas
+*                         bort, en tilldelning erstter en fregende
+*                         tilldelning eller insttning p samma index och
+*                         en borttagning som direkt tar bort ett nyss
+*                         tillagt element tar ut varandra. Den komprimerade
+*                         loggen kodas i en ny buffert, som erstter loggens
+*                         innehll frst nr samtliga operationer har
+*                         lagrats. Ifall loggen redan har frlorat ngon
+*                         operation, r felaktig eller vid misslyckad
+*                         minnesallokering returneras 1, varvid loggen
+*                         lmnas ofrndrad. Annars returneras 0.
+*
+*                         - self: Pekare till ndringsloggen.
+*******************************************************************************/
+int double_journal_compact(struct double_journal* self)
+{
+   struct double_journal_op* ops = 0;
+   struct double_journal compacted;
+   size_t num_ops = 0;
+   size_t pos = 0;
+
+   if (self->error) return 1;
+   if (!self->size) return 0;
+   ops = (struct double_journal_op*)malloc(sizeof(struct double_journal_op) * self->size);
+   if (!ops) return 1;
+
+   while (pos < self->size)
+   {
+      struct double_journal_op op;
+      struct double_journal_op* prev = num_ops ? &ops[num_ops - 1] : 0;
+
+      if (double_journal_decode(self, &pos, &op))
+      {
+         free(ops);
+         return 1;
+      }
+
+      if (op.op == DOUBLE_JOURNAL_CLEAR)
+      {
+         num_ops = 0;
+         ops[num_ops++] = op;
+      }
+      else if (prev &&
+               ((op.op == DOUBLE_JOURNAL_POP_FRONT &&
+                 prev->op == DOUBLE_JOURNAL_PUSH_FRONT) ||
+                (op.op == DOUBLE_JOURNAL_POP_BACK &&
+                 prev->op == DOUBLE_JOURNAL_PUSH_BACK) ||
+                (op.op == DOUBLE_JOURNAL_REMOVE &&
+                 prev->op == DOUBLE_JOURNAL_INSERT &&
+                 op.index == prev->index) ||
+                (op.op == DOUBLE_JOURNAL_REMOVE &&
+                 prev->op == DOUBLE_JOURNAL_PUSH_FRONT &&
+                 op.index == 0)))
+      {
+         num_ops--;
+      }
+      else if (prev && op.op == DOUBLE_JOURNAL_ASSIGN &&
+               (((prev->op == DOUBLE_JOURNAL_ASSIGN ||
+                  prev->op == DOUBLE_JOURNAL_INSERT) &&
+                 op.index == prev->index) ||
+                (prev->op == DOUBLE_JOURNAL_PUSH_FRONT &&
+                 op.index == 0)))
+      {
+         prev->val = op.val;
+      }
+      else
+      {
+         ops[num_ops++] = op;
+      }
+   }
+
+   double_journal_new(&compacted);
+
+   for (size_t i = 0; i < num_ops; ++i)
+   {
+      if (double_journal_log(&compacted, ops[i].op, ops[i].index, ops[i].val))
+      {
+         double_journal_delete(&compacted);
+         free(ops);
+         return 1;
+      }
+   }
+
+   free(ops);
+   free(self->data);
+   *self = compacted;
+   return 0;
+}
+
+/*******************************************************************************
+* double_journal_write: Skriver angiven ndringslogg till angiven utstrm som
+*                       en ram bestende av loggens storlek i byte (tta byte
+*                       i little endian) fljt av loggens innehll. Ifall
+*                       loggen r strre n DOUBLE_JOURNAL_MAX_FRAME_SIZE
+*                       eller vid skrivfel returneras 1, annars 0.
+*
+*                       - self   : Pekare till ndringsloggen.
+*                       - ostream: Pekare till aktuell utstrm.
+*******************************************************************************/
+int double_journal_write(const struct double_journal* self,
+                         FILE* ostream)
+{
+   unsigned char header[8];
+   const uint64_t size = (uint64_t)self->size;
+   if (self->size > DOUBLE_JOURNAL_MAX_FRAME_SIZE) return 1;
+
+   for (int i = 0; i < 8; ++i)
+   {
+      header[i] = (unsigned char)(size >> (8 * i));
+   }
+
+   if (fwrite(header, 1, sizeof(header), ostream) != sizeof(header)) return 1;
+   if (self->size && fwrite(self->data, 1, self->size, ostream) != self->size) return 1;
+   return fflush(ostream) != 0;
+}
+
+/*******************************************************************************
+* double_journal_read: Lser en ram skriven av double_journal_write frn
+*                      angiven instrm och lgger till dess innehll sist i
+*                      angiven ndringslogg. Vid filslut, lsfel, en ram
+*                      strre n DOUBLE_JOURNAL_MAX_FRAME_SIZE eller
+*                      misslyckad minnesallokering returneras 1, annars 0.
+*
+*                      - self   : Pekare till ndringsloggen.
+*                      - istream: Pekare till aktuell instrm.
+*******************************************************************************/
+int double_journal_read(struct double_journal* self,
+                        FILE* istream)
+{
+   unsigned char header[8];
+   uint64_t size = 0;
+
+   if (fread(header, 1, sizeof(header), istream) != sizeof(header)) return 1;
+
+   for (int i = 0; i < 8; ++i)
+   {
+      size |= (uint64_t)header[i] << (8 * i);
+   }
+
+   if (size > DOUBLE_JOURNAL_MAX_FRAME_SIZE) return 1;
+   if (double_journal_reserve(self, (size_t)size)) return 1;
+   if (fread(self->data + self->size, 1, (size_t)size, istream) != (size_t)size) return 1;
+
+   self->size += (size_t)size;
+   return 0;
+}
+
+/*******************************************************************************
+* double_journal_reserve: Skerstller att angiven ndringslogg rymmer
+*                         ytterligare angivet antal byte. Vid behov dubblas
+*                         kapaciteten, dock aldrig frbi SIZE_MAX. Ifall
+*                         storleken inte kan representeras eller vid
+*                         misslyckad minnesallokering returneras 1, annars 0.
+*
+*                         - self: Pekare till ndringsloggen.
+*                         - size: Antalet byte som skall f plats.
+*******************************************************************************/
+static int double_journal_reserve(struct double_journal* self,
+                                  const size_t size)
+{
+   size_t new_capacity = self->capacity ? self->capacity : 64;
+   unsigned char* copy = 0;
+
+   if (size > SIZE_MAX - self->size) return 1;
+   if (self->size + size <= self->capacity) return 0;
+
+   while (new_capacity < self->size + size)
+   {
+      if (new_capacity > SIZE_MAX / 2)
+      {
+         new_capacity = self->size + size;
+         break;
+      }
+
+      new_capacity *= 2;
+   }
+
+   copy = (unsigned char*)realloc(self->data, new_capacity);
+   if (!copy) return 1;
+
+   self->data = copy;
+   self->capacity = new_capacity;
+   return 0;
+}
+
+/*******************************************************************************
+* double_journal_has_index: Indikerar ifall angiven operation lagrar ett index.
+*
+*                           - op: Operationskoden.
+*******************************************************************************/
+static int double_journal_has_index(const unsigned char op)
+{
+   return op == DOUBLE_JOURNAL_INSERT || op == DOUBLE_JOURNAL_REMOVE ||
+          op == DOUBLE_JOURNAL_ASSIGN;
+}
+
+/*******************************************************************************
+* double_journal_has_value: Indikerar ifall angiven operation lagrar ett
+*                           flyttal.
+*
+*                           - op: Operationskoden.
+*******************************************************************************/
+static int double_journal_has_value(const unsigned char op)
+{
+   return op == DOUBLE_JOURNAL_PUSH_FRONT || op == DOUBLE_JOURNAL_PUSH_BACK ||
+          op == DOUBLE_JOURNAL_INSERT || op == DOUBLE_JOURNAL_ASSIGN;
+}
+
+/*******************************************************************************
+* double_journal_decode: Avkodar operationen som brjar p angiven position i
+*                        en ndringslogg och flyttar positionen till nsta
+*                        operation. Vid oknd operationskod eller ofullstndig
+*                        operation returneras 1, annars 0.
+*
+*                        - self: Pekare till ndringsloggen.
+*                        - pos : Pekare till aktuell position i loggen.
+*                        - op  : Pekare till den operation som skall tilldelas.
+*******************************************************************************/
+static int double_journal_decode(const struct double_journal* self,
+                                 size_t* pos,
+                                 struct double_journal_op* op)
+{
+   op->op = self->data[(*pos)++];
+   op->index = 0;
+   op->val = 0;
+
+   if (op->op < DOUBLE_JOURNAL_PUSH_FRONT || op->op > DOUBLE_JOURNAL_CLEAR) return 1;
+
+   if (double_journal_has_index(op->op))
+   {
+      unsigned shift = 0;
+
+      while (1)
+      {
+         unsigned char byte = 0;
+         if (*pos >= self->size || shift >= 8 * sizeof(size_t)) return 1;
+
+         byte = self->data[(*pos)++];
+         op->index |= (size_t)(byte & 0x7f) << shift;
+         shift += 7;
+         if (!(byte & 0x80)) break;
+      }
+   }
+
+   if (double_journal_has_value(op->op))
+   {
+      uint64_t bits = 0;
+      if (self->size - *pos < 8) return 1;
+
+      for (int i = 0; i < 8; ++i)
+      {
+         bits |= (uint64_t)self->data[(*pos)++] << (8 * i);
+      }
+
+      memcpy(&op->val, &bits, sizeof(bits));
+   }
+
+   return 0;
+}
\ No newline at end of file
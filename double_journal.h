@@ -0,0 +1,61 @@
+/*******************************************************************************
+* double_journal.h: Innehller funktionalitet fr en ndringslogg som
+*                   registrerar frndringar av dubbellnkade listor av
+*                   strukten double_list i ett kompakt binrt format. Loggen
+*                   kan skickas till en annan process via en fil eller ett
+*                   rr och dr spelas upp p en kopia av listan, s att
+*                   endast frndringarna behver verfras.
+*******************************************************************************/
+#ifndef DOUBLE_JOURNAL_H_
+#define DOUBLE_JOURNAL_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Makrodefinitioner (operationskoder): */
+#define DOUBLE_JOURNAL_PUSH_FRONT 1 /* Flyttal placeras frst i listan. */
+#define DOUBLE_JOURNAL_PUSH_BACK 2  /* Flyttal placeras sist i listan. */
+#define DOUBLE_JOURNAL_POP_FRONT 3  /* Frsta elementet tas bort. */
+#define DOUBLE_JOURNAL_POP_BACK 4   /* Sista elementet tas bort. */
+#define DOUBLE_JOURNAL_INSERT 5     /* Flyttal placeras p angivet index. */
+#define DOUBLE_JOURNAL_REMOVE 6     /* Elementet p angivet index tas bort. */
+#define DOUBLE_JOURNAL_ASSIGN 7     /* Elementet p angivet index tilldelas. */
+#define DOUBLE_JOURNAL_CLEAR 8      /* Listan tms. */
+
+/* Makrodefinitioner: */
+#define DOUBLE_JOURNAL_MAX_FRAME_SIZE ((size_t)1 << 30) /* Strsta tilltna ram i byte. */
+
+struct double_list;
+
+/*******************************************************************************
+* double_journal: Implementering av en ndringslogg. Varje operation lagras
+*                 som en operationskod om en byte, fljt av ett eventuellt
+*                 index kodat med variabel lngd (sju bitar per byte) samt
+*                 ett eventuellt flyttal lagrat som tta byte i little endian.
+*******************************************************************************/
+struct double_journal
+{
+   unsigned char* data; /* Loggens binra innehll. */
+   size_t size;         /* Antalet lagrade byte. */
+   size_t capacity;     /* Antalet allokerade byte. */
+   int error;           /* Indikerar ifall ngon operation gtt frlorad. */
+};
+
+/* Externa funktioner: */
+void double_journal_new(struct double_journal* self);
+void double_journal_delete(struct double_journal* self);
+void double_journal_clear(struct double_journal* self);
+int double_journal_log(struct double_journal* self,
+                       const unsigned char op,
+                       const size_t index,
+                       const double val);
+int double_journal_apply(const struct double_journal* self,
+                         struct double_list* list);
+int double_journal_compact(struct double_journal* self);
+int double_journal_write(const struct double_journal* self,
+                         FILE* ostream);
+int double_journal_read(struct double_journal* self,
+                        FILE* istream);
+
+#endif /* DOUBLE_JOURNAL_H_ */
\ No newline at end of file
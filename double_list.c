@@ -4,9 +4,30 @@
 *******************************************************************************/
 #include "double_list.h"
 
+/* Statiska variabler: */
+static int (*double_list_free_hook)(struct double_node* first,
+                                    const size_t size,
+                                    struct double_index* index) = 0;
+
 /* Statiska funktioner: */
 static struct double_node* double_node_new(const double data);
 static void double_node_delete(struct double_node** self);
+static void double_list_release(struct double_list* self,
+                                const int keep_index);
+static void double_list_index_add(struct double_list* self,
+                                  struct double_node* node);
+static void double_list_index_erase(struct double_list* self,
+                                    const struct double_node* node);
+static void double_list_assign_node(struct double_list* self,
+                                    struct double_node* node,
+                                    const double val);
+static void double_list_journal_log(struct double_list* self,
+                                    const unsigned char op,
+                                    const size_t index,
+                                    const double val);
+static void double_list_journal_snapshot(struct double_list* self);
+static size_t double_list_position_of(const struct double_list* self,
+                                      const struct double_node* node);
 
 /*******************************************************************************
 * double_list_new: Initierar tom lnkad lista.
@@ -18,27 +39,22 @@ void double_list_new(struct double_list* self)
    self->first = 0;
    self->last = 0;
    self->size = 0;
+   self->index = 0;
+   self->journal = 0;
    return;
 }
 
 /*******************************************************************************
 * double_list_delete: Tmmer angiven lnkad lista genom att frigra minne fr
-*                     allokerade noder och nollstller listans parametrar.
+*                     allokerade noder och nollstller listans parametrar,
+*                     se double_list_clear. Till skillnad frn
+*                     double_list_clear frigrs ven ett eventuellt hashindex.
 * 
 *                     - self: Pekare till den lnkade listan.
 *******************************************************************************/
 void double_list_delete(struct double_list* self)
 {
-   for (struct double_node* i = self->first; i; )
-   {
-      struct double_node* next = i->next;
-      double_node_delete(&i);
-      i = next;
-   }
-
-   self->first = 0;
-   self->last = 0;
-   self->size = 0;
+   double_list_release(self, 0);
    return;
 }
 
@@ -93,13 +109,13 @@ struct double_node* double_list_begin(const struct double_list* self)
 
 /*******************************************************************************
 * double_list_end: Returnerar adressen direkt efter sista noden i angiven
-*                  lnkad lista.
+*                  lnkad lista. Fr en tom lista returneras null.
 * 
 *                  - self: Pekare till den lnkade listan.
 *******************************************************************************/
 struct double_node* double_list_end(const struct double_list* self)
 {
-   return self->last->next;
+   return self->last ? self->last->next : 0;
 }
 
 /*******************************************************************************
@@ -154,10 +170,12 @@ int double_list_push_front(struct double_list* self,
    else
    {
       n1->next = n2;
-      n2->previous = n2;
+      n2->previous = n1;
       self->first = n1;
    }
 
+   double_list_index_add(self, n1);
+   double_list_journal_log(self, DOUBLE_JOURNAL_PUSH_FRONT, 0, data);
    return 0;
 }
 
@@ -187,6 +205,8 @@ int double_list_push_back(struct double_list* self,
       self->last = n2;
    }
 
+   double_list_index_add(self, n2);
+   double_list_journal_log(self, DOUBLE_JOURNAL_PUSH_BACK, 0, data);
    return 0;
 }
 
@@ -197,16 +217,20 @@ int double_list_push_back(struct double_list* self,
 *******************************************************************************/
 void double_list_pop_front(struct double_list* self)
 {
-   if (self->size <= 1)
+   if (!self->size)
    {
-      double_list_delete(self);
+      return;
    }
    else
    {
       struct double_node* n1 = self->first;
       struct double_node* n2 = n1->next;
 
-      n2->previous = 0;
+      if (n2) n2->previous = 0;
+      else self->last = 0;
+
+      double_list_index_erase(self, n1);
+      double_list_journal_log(self, DOUBLE_JOURNAL_POP_FRONT, 0, 0);
       double_node_delete(&n1);
       self->first = n2;
       self->size--;
@@ -221,16 +245,20 @@ void double_list_pop_front(struct double_list* self)
 *******************************************************************************/
 void double_list_pop_back(struct double_list* self)
 {
-   if (self->size <= 1)
+   if (!self->size)
    {
-      double_list_delete(self);
+      return;
    }
    else
    {
       struct double_node* n2 = self->last;
       struct double_node* n1 = n2->previous;
 
-      n1->next = 0;
+      if (n1) n1->next = 0;
+      else self->first = 0;
+
+      double_list_index_erase(self, n2);
+      double_list_journal_log(self, DOUBLE_JOURNAL_POP_BACK, 0, 0);
       double_node_delete(&n2);
 
       self->last = n1;
@@ -273,6 +301,8 @@ int double_list_insert_at_index(struct double_list* self,
       n2->next = n3;
       n3->previous = n2;
 
+      double_list_index_add(self, n2);
+      double_list_journal_log(self, DOUBLE_JOURNAL_INSERT, index, val);
       self->size++;
       return 0;
    }
@@ -312,12 +342,19 @@ int double_list_insert_at_address(struct double_list* self,
       struct double_node* n1 = n3->previous;
 
       if (!n2) return 1;
+      if (self->journal)
+      {
+         double_list_journal_log(self, DOUBLE_JOURNAL_INSERT,
+                                 double_list_position_of(self, n3), val);
+      }
 
       n1->next = n2;
       n2->previous = n1;
 
       n2->next = n3;
       n3->previous = n2;
+
+      double_list_index_add(self, n2);
       self->size++;
       return 0;
    }
@@ -333,15 +370,21 @@ int double_list_insert_at_address(struct double_list* self,
 int double_list_remove_at_index(struct double_list* self,
                                 const size_t index)
 {
-   if (index == 0)
+   if (index >= self->size)
+   {
+      return 1;
+   }
+   else if (index == 0)
    {
       double_list_pop_front(self);
+      return 0;
    }
    else if (index == self->size - 1)
    {
       double_list_pop_back(self);
+      return 0;
    }
-   if (index < self->size)
+   else
    {
       struct double_node* n2 = double_list_node_at(self, index);
       struct double_node* n1 = n2->previous;
@@ -350,14 +393,12 @@ int double_list_remove_at_index(struct double_list* self,
       n1->next = n3;
       n3->previous = n1;
 
+      double_list_index_erase(self, n2);
+      double_list_journal_log(self, DOUBLE_JOURNAL_REMOVE, index, 0);
       double_node_delete(&n2);
       self->size--;
       return 0;
    }
-   else
-   {
-      return 1;
-   }
 }
 
 /*******************************************************************************
@@ -386,9 +427,16 @@ void double_list_remove_at_address(struct double_list* self,
       struct double_node* n1 = n2->previous;
       struct double_node* n3 = n2->next;
 
+      if (self->journal)
+      {
+         double_list_journal_log(self, DOUBLE_JOURNAL_REMOVE,
+                                 double_list_position_of(self, n2), 0);
+      }
+
       n1->next = n3;
       n3->previous = n1;
 
+      double_list_index_erase(self, n2);
       double_node_delete(&n2);
       self->size--;
    }
@@ -408,7 +456,8 @@ void double_list_assign_at_index(struct double_list* self,
 {
    if (index < self->size)
    {
-      double_list_node_at(self, index)->data = val;
+      double_list_assign_node(self, double_list_node_at(self, index), val);
+      double_list_journal_log(self, DOUBLE_JOURNAL_ASSIGN, index, val);
    }
    return;
 }
@@ -418,6 +467,8 @@ void double_list_assign_at_index(struct double_list* self,
 *                                adress i angiven lnkad lista. Ingen kontroll
 *                                genomfrs gllande ifall angiven adress r
 *                                korrekt, vilket mste sktas av anvndaren.
+*                                Ifall listan har en ndringslogg berknas
+*                                nodens index via iteration genom listan.
 * 
 *                                - self   : Pekare till den lnkade listan.
 *                                - address: Pekar p nod som skall tilldelas.
@@ -427,7 +478,13 @@ void double_list_assign_at_address(struct double_list* self,
                                    struct double_node* address, 
                                    const double val)
 {
-   address->data = val;
+   double_list_assign_node(self, address, val);
+
+   if (self->journal)
+   {
+      double_list_journal_log(self, DOUBLE_JOURNAL_ASSIGN,
+                              double_list_position_of(self, address), val);
+   }
    return;
 }
 
@@ -477,25 +534,15 @@ double double_list_at_address(const struct double_list* self,
 int double_list_copy(struct double_list* self,
                      const struct double_list* source)
 {
-   double_list_delete(self);
-   double_list_resize(self, source->size);
+   if (self == source) return 0;
+   double_list_clear(self);
 
-   if (self->size == source->size)
+   for (const struct double_node* i = source->first; i; i = i->next)
    {
-      struct double_node* n1 = self->first;
-
-      for (struct double_node* i = source->first; i != source->last->next; i = i->next)
-      {
-         n1->data = i->data;
-         n1 = n1->next;
-      }
-
-      return 0;
-   }
-   else
-   {
-      return 1;
+      if (double_list_push_back(self, i->data)) return 1;
    }
+
+   return 0;
 }
 
 /*******************************************************************************
@@ -516,26 +563,15 @@ int double_list_join(struct double_list* self,
    }
    else
    {
-      const size_t new_size = self->size + other_list->size;
-      struct double_node* n1 = self->last;
-      double_list_resize(self, new_size);
+      const struct double_node* i = other_list->first;
 
-      if (self->size != new_size)
+      for (size_t n = other_list->size; n > 0; --n)
       {
-         return 1;
+         if (double_list_push_back(self, i->data)) return 1;
+         i = i->next;
       }
-      else
-      {
-         n1 = n1->next;
 
-         for (struct double_node* i = other_list->first; i != other_list->last->next; i = i->next)
-         {
-            n1->data = i->data;
-            n1 = n1->next;
-         }
-
-         return 0;
-      }
+      return 0;
    }
 }
 
@@ -556,10 +592,15 @@ void double_list_move(struct double_list* self,
    self->first = source->first;
    self->last = source->last;
    self->size = source->size;
+   self->index = source->index;
 
    source->first = 0;
    source->last = 0;
    source->size = 0;
+   source->index = 0;
+
+   double_list_journal_log(source, DOUBLE_JOURNAL_CLEAR, 0, 0);
+   double_list_journal_snapshot(self);
    return;
 }
 
@@ -617,11 +658,252 @@ struct double_node* double_list_node_at(const struct double_list* self,
 }
 
 /*******************************************************************************
-* double_list_clear: Tmmer och nollstller lnkad lista.
+* double_list_index_enable: Aktiverar ett hashindex fr angiven lnkad lista,
+*                           vilket medfr att skning efter lagrade flyttal
+*                           via double_list_find, double_list_contains samt
+*                           double_list_remove_value sker i konstant tid.
+*                           Indexet uppdateras av samtliga funktioner som
+*                           ndrar listans innehll. Vid misslyckad
+*                           minnesallokering returneras 1, annars 0.
+*
+*                           - self: Pekare till den lnkade listan.
+*******************************************************************************/
+int double_list_index_enable(struct double_list* self)
+{
+   if (self->index) return 0;
+   self->index = double_index_ptr_new();
+   if (!self->index) return 1;
+
+   for (struct double_node* i = self->first; i; i = i->next)
+   {
+      if (double_index_insert(self->index, i))
+      {
+         double_index_ptr_delete(&self->index);
+         return 1;
+      }
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+* double_list_index_disable: Inaktiverar och frigr hashindexet fr angiven
+*                            lnkad lista. Efterfljande skningar sker
+*                            via iteration genom listan.
+*
+*                            - self: Pekare till den lnkade listan.
+*******************************************************************************/
+void double_list_index_disable(struct double_list* self)
+{
+   double_index_ptr_delete(&self->index);
+   return;
+}
+
+/*******************************************************************************
+* double_list_find: Returnerar adressen till en nod som lagrar angivet flyttal.
+*                   Ifall listan saknar hashindex sks listan igenom frn
+*                   brjan och den frsta matchande noden returneras. Med
+*                   hashindex sker skningen i konstant tid, men vid dubbletter
+*                   r det d odefinierat vilken nod som returneras. Ifall
+*                   ingen nod lagrar flyttalet returneras null. NaN-vrden
+*                   matchar varandra och +0 matchar -0.
+*
+*                   - self: Pekare till den lnkade listan.
+*                   - val : Det flyttal som skall skas efter.
+*******************************************************************************/
+struct double_node* double_list_find(const struct double_list* self,
+                                     const double val)
+{
+   if (self->index)
+   {
+      return double_index_find(self->index, val);
+   }
+   else
+   {
+      for (struct double_node* i = self->first; i; i = i->next)
+      {
+         if (double_index_equal(i->data, val)) return i;
+      }
+
+      return 0;
+   }
+}
+
+/*******************************************************************************
+* double_list_contains: Indikerar ifall angivet flyttal lagras i angiven
+*                       lnkad lista.
+*
+*                       - self: Pekare till den lnkade listan.
+*                       - val : Det flyttal som skall skas efter.
+*******************************************************************************/
+int double_list_contains(const struct double_list* self,
+                         const double val)
+{
+   return double_list_find(self, val) != 0;
+}
+
+/*******************************************************************************
+* double_list_remove_value: Tar bort en nod som lagrar angivet flyttal ur
+*                           angiven lnkad lista. Ifall inget sdant flyttal
+*                           hittas returneras 1, annars 0.
+*
+*                           - self: Pekare till den lnkade listan.
+*                           - val : Det flyttal som skall tas bort.
+*******************************************************************************/
+int double_list_remove_value(struct double_list* self,
+                             const double val)
+{
+   struct double_node* node = double_list_find(self, val);
+   if (!node) return 1;
+   double_list_remove_at_address(self, node);
+   return 0;
+}
+
+/*******************************************************************************
+* double_list_verify: Kontrollerar att angiven lnkad lista r konsistent,
+*                     vilket exempelvis kan anvndas fr att jmfra listan
+*                     mot en referensmodell efter varje operation vid
+*                     randomiserad testning. Lnkarna kontrolleras i bda
+*                     riktningar, antalet noder jmfrs med listans storlek
+*                     och varje nod mste terfinnas i ett eventuellt
+*                     hashindex. Ifall listan r konsistent returneras 0,
+*                     annars 1.
+*
+*                     - self: Pekare till den lnkade listan.
+*******************************************************************************/
+int double_list_verify(const struct double_list* self)
+{
+   const struct double_node* previous = 0;
+   size_t count = 0;
+
+   for (const struct double_node* i = self->first; i; i = i->next)
+   {
+      if (i->previous != previous || ++count > self->size) return 1;
+      if (self->index && !double_index_contains(self->index, i)) return 1;
+      previous = i;
+   }
+
+   if (self->last != previous || count != self->size) return 1;
+   if (self->index && self->index->size != self->size) return 1;
+   return 0;
+}
+
+/*******************************************************************************
+* double_list_journal_attach: Kopplar angiven ndringslogg till angiven lnkad
+*                             lista, varefter samtliga frndringar av listan
+*                             registreras i loggen. Listan ger inte loggen,
+*                             utan den mste frigras av anvndaren efter att
+*                             den kopplats bort genom att null passeras.
+*                             Vid anslutning registreras en gonblicksbild
+*                             av listans innehll (en tmning fljd av
+*                             samtliga element), s att en tom kopia kan
+*                             byggas upp enbart frn loggen. Operationer
+*                             som refererar till en nod via dess adress
+*                             registreras med nodens index, vilket berknas
+*                             via iteration genom listan.
+*
+*                             - self   : Pekare till den lnkade listan.
+*                             - journal: Pekare till ndringsloggen (eller
+*                                        null).
+*******************************************************************************/
+void double_list_journal_attach(struct double_list* self,
+                                struct double_journal* journal)
+{
+   if (journal == self->journal) return;
+   self->journal = journal;
+   double_list_journal_snapshot(self);
+   return;
+}
+
+/*******************************************************************************
+* double_list_clear: Tmmer och nollstller lnkad lista. Ett eventuellt
+*                    hashindex tms men behlls, s att skning fortstter
+*                    att ske i konstant tid. Ifall en funktion fr frdrjd
+*                    frigrelse har installerats via double_list_set_free_hook
+*                    (exempelvis av double_reclaimer_start) lmnas stora
+*                    nodkedjor i stllet ver till denna, se
+*                    double_reclaimer.h. Hashindexets tabeller lmnas d
+*                    ver tillsammans med noderna och erstts av ett nytt
+*                    tomt index (ifall detta inte kan allokeras inaktiveras
+*                    indexet). En eventuell ndringslogg behlls och
+*                    registrerar tmningen.
 * 
 *                    - self: Pekare till den lnkade listan.
 *******************************************************************************/
-void (*double_list_clear)(struct double_list* self) = &double_list_delete;
+void double_list_clear(struct double_list* self)
+{
+   double_list_release(self, 1);
+   return;
+}
+
+/*******************************************************************************
+* double_list_set_free_hook: Installerar en funktion fr frdrjd frigrelse,
+*                            som drefter anropas av double_list_clear samt
+*                            double_list_delete med listans nodkedja, dess
+*                            storlek samt listans eventuella hashindex.
+*                            Funktionen skall returnera 0 ifall den har tagit
+*                            ver ansvaret fr bde noderna och indexet,
+*                            annars 1, varvid listan sjlv frigr dem. Utan
+*                            installerad funktion (default) frigrs noderna
+*                            direkt, vilket medfr att listan inte r beroende
+*                            av double_reclaimer.c eller pthreads.
+*                            Installation mste ske innan andra trdar
+*                            anvnder lnkade listor.
+*
+*                            - hook: Pekare till funktionen (eller null fr
+*                                    att terg till direkt frigrelse).
+*******************************************************************************/
+void double_list_set_free_hook(int (*hook)(struct double_node* first,
+                                           const size_t size,
+                                           struct double_index* index))
+{
+   double_list_free_hook = hook;
+   return;
+}
+
+/*******************************************************************************
+* double_list_release: Frigr listans noder, antingen direkt eller via
+*                      installerad funktion fr frdrjd frigrelse, och
+*                      nollstller listan. Vid verlmning lmnas ven ett
+*                      eventuellt hashindex ver, s att varken noder eller
+*                      indexets tabeller frigrs av anroparen.
+*
+*                      - self      : Pekare till den lnkade listan.
+*                      - keep_index: Indikerar ifall hashindexet skall
+*                                    behllas (tmt) eller frigras.
+*******************************************************************************/
+static void double_list_release(struct double_list* self,
+                                const int keep_index)
+{
+   if (double_list_free_hook && !double_list_free_hook(self->first, self->size, self->index))
+   {
+      self->index = keep_index && self->index ? double_index_ptr_new() : 0;
+   }
+   else
+   {
+      for (struct double_node* i = self->first; i; )
+      {
+         struct double_node* next = i->next;
+         double_node_delete(&i);
+         i = next;
+      }
+
+      if (!keep_index)
+      {
+         double_index_ptr_delete(&self->index);
+      }
+      else if (self->index)
+      {
+         double_index_clear(self->index);
+      }
+   }
+
+   double_list_journal_log(self, DOUBLE_JOURNAL_CLEAR, 0, 0);
+   self->first = 0;
+   self->last = 0;
+   self->size = 0;
+   return;
+}
 
 /*******************************************************************************
 * double_node_new: Returnerar en ny nod som lagrar angivet flyttal.
@@ -649,4 +931,110 @@ static void double_node_delete(struct double_node** self)
    free(*self);
    *self = 0;
    return;
+}
+
+/*******************************************************************************
+* double_list_index_add: Lgger till angiven nod i listans hashindex, om ett
+*                        sdant r aktiverat. Ifall minnesallokering
+*                        misslyckas frigrs indexet, s att efterfljande
+*                        skningar sker via iteration i stllet fr att
+*                        returnera felaktiga resultat.
+*
+*                        - self: Pekare till den lnkade listan.
+*                        - node: Pekare till den nod som skall indexeras.
+*******************************************************************************/
+static void double_list_index_add(struct double_list* self,
+                                  struct double_node* node)
+{
+   if (self->index && double_index_insert(self->index, node))
+   {
+      double_index_ptr_delete(&self->index);
+   }
+   return;
+}
+
+/*******************************************************************************
+* double_list_index_erase: Tar bort angiven nod ur listans hashindex, om ett
+*                          sdant r aktiverat.
+*
+*                          - self: Pekare till den lnkade listan.
+*                          - node: Pekare till den nod som skall tas bort.
+*******************************************************************************/
+static void double_list_index_erase(struct double_list* self,
+                                    const struct double_node* node)
+{
+   if (self->index) double_index_remove(self->index, node);
+   return;
+}
+
+/*******************************************************************************
+* double_list_assign_node: Tilldelar ett flyttal till angiven nod och
+*                          uppdaterar listans hashindex, om ett sdant r
+*                          aktiverat.
+*
+*                          - self: Pekare till den lnkade listan.
+*                          - node: Pekare till noden som skall tilldelas.
+*                          - val : Flyttalet som skall tilldelas.
+*******************************************************************************/
+static void double_list_assign_node(struct double_list* self,
+                                    struct double_node* node,
+                                    const double val)
+{
+   double_list_index_erase(self, node);
+   node->data = val;
+   double_list_index_add(self, node);
+   return;
+}
+
+/*******************************************************************************
+* double_list_journal_log: Registrerar en operation i listans ndringslogg,
+*                          om en sdan r kopplad till listan.
+*
+*                          - self : Pekare till den lnkade listan.
+*                          - op   : Operationskod (DOUBLE_JOURNAL_*).
+*                          - index: Index som operationen avser.
+*                          - val  : Flyttal som operationen lagrar.
+*******************************************************************************/
+static void double_list_journal_log(struct double_list* self,
+                                    const unsigned char op,
+                                    const size_t index,
+                                    const double val)
+{
+   if (self->journal) double_journal_log(self->journal, op, index, val);
+   return;
+}
+
+/*******************************************************************************
+* double_list_journal_snapshot: Registrerar listans fullstndiga innehll i
+*                               dess ndringslogg som en tmning fljd av
+*                               ett tillgg sist per element, om en
+*                               ndringslogg r kopplad till listan.
+*
+*                               - self: Pekare till den lnkade listan.
+*******************************************************************************/
+static void double_list_journal_snapshot(struct double_list* self)
+{
+   if (!self->journal) return;
+   double_list_journal_log(self, DOUBLE_JOURNAL_CLEAR, 0, 0);
+
+   for (const struct double_node* i = self->first; i; i = i->next)
+   {
+      double_list_journal_log(self, DOUBLE_JOURNAL_PUSH_BACK, 0, i->data);
+   }
+   return;
+}
+
+/*******************************************************************************
+* double_list_position_of: Returnerar index fr angiven nod i en lnkad lista
+*                          via iteration frn listans brjan.
+*
+*                          - self: Pekare till den lnkade listan.
+*                          - node: Pekare till noden vars index sks.
+*******************************************************************************/
+static size_t double_list_position_of(const struct double_list* self,
+                                      const struct double_node* node)
+{
+   size_t index = 0;
+   for (const struct double_node* i = self->first; i && i != node; i = i->next) index++;
+   return index;
 }
\ No newline at end of file
@@ -9,15 +9,19 @@
 /* Inkluderingsdirektiv: */
 #include <stdio.h>
 #include <stdlib.h>
+#include "double_index.h"
+#include "double_journal.h"
 
 /*******************************************************************************
 * double_list: Implementering av en dubbellnkad lista fr lagring av flyttal.
 *******************************************************************************/
 struct double_list
 {
-   struct double_node* first; /* Pekare till frsta elementet i listan. */
-   struct double_node* last;  /* Pekare till det sista elementet i listan. */
-   size_t size;               /* Listans storlek (antalet element i listan). */
+   struct double_node* first;      /* Pekare till frsta elementet i listan. */
+   struct double_node* last;       /* Pekare till det sista elementet i listan. */
+   size_t size;                    /* Listans storlek (antalet element i listan). */
+   struct double_index* index;     /* Valfritt hashindex fr skning (eller null). */
+   struct double_journal* journal; /* Valfri ndringslogg (eller null). */
 };
 
 /*******************************************************************************
@@ -80,8 +84,20 @@ void double_list_print(const struct double_list* self,
                        FILE* ostream);
 struct double_node* double_list_node_at(const struct double_list* self,
                                         const size_t index);
-
-/* Funktionspekare: */
-extern void (*double_list_clear)(struct double_list* self);
+int double_list_index_enable(struct double_list* self);
+void double_list_index_disable(struct double_list* self);
+struct double_node* double_list_find(const struct double_list* self,
+                                     const double val);
+int double_list_contains(const struct double_list* self,
+                         const double val);
+int double_list_remove_value(struct double_list* self,
+                             const double val);
+int double_list_verify(const struct double_list* self);
+void double_list_journal_attach(struct double_list* self,
+                                struct double_journal* journal);
+void double_list_clear(struct double_list* self);
+void double_list_set_free_hook(int (*hook)(struct double_node* first,
+                                           const size_t size,
+                                           struct double_index* index));
 
 #endif /* DOUBLE_LIST_H_ */
\ No newline at end of file
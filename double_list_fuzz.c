@@ -0,0 +1,69 @@
+/*******************************************************************************
+* double_list_fuzz.c: Fuzzningsml fr libFuzzer (samt AFL) som tolkar
+*                     indata som en fljd av operationer p en dubbellnkad
+*                     lista, vilka genomfrs bde p listan och p
+*                     referensmodellen i double_list_model.c. Ifall listan
+*                     avviker frn modellen avbryts programmet via abort.
+*
+*                     Kompilering fr libFuzzer:
+*                     clang -g -O1 -fsanitize=fuzzer,address,undefined -I.
+*                           double_list_fuzz.c double_list_model.c
+*                           double_list.c double_index.c double_journal.c
+*                           double_reclaimer.c double_view.c -lm -pthread
+*                           -o double_list_fuzz
+*
+*                     Kompilering fr AFL (indata lses frn stdin):
+*                     afl-clang-fast -g -fsanitize=address,undefined
+*                           -DDOUBLE_LIST_FUZZ_STANDALONE -I.
+*                           double_list_fuzz.c double_list_model.c
+*                           double_list.c double_index.c double_journal.c
+*                           double_reclaimer.c double_view.c -lm -pthread
+*                           -o double_list_fuzz
+*******************************************************************************/
+#include "double_list_model.h"
+#include <stdint.h>
+
+/*******************************************************************************
+* LLVMFuzzerTestOneInput: Genomfr operationerna i angiven indata. Varje
+*                         operation bestr av fyra byte: operationskod,
+*                         argument (tv byte i little endian) samt index till
+*                         flyttalet som anvnds. Efter samtliga operationer
+*                         synkroniseras kopian via ndringsloggen en sista
+*                         gng och jmfrs mot modellen.
+*
+*                         - data: Pekare till indata.
+*                         - size: Antalet byte i indata.
+*******************************************************************************/
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+   struct double_list_model model;
+   if (double_list_model_new(&model)) return 0;
+
+   for (size_t i = 0; i + 4 <= size; i += 4)
+   {
+      const size_t arg = (size_t)data[i + 1] | ((size_t)data[i + 2] << 8);
+
+      if (double_list_model_step(&model, data[i], arg, data[i + 3]))
+      {
+         abort();
+      }
+   }
+
+   if (double_list_model_step(&model, DOUBLE_LIST_MODEL_JOURNAL_SYNC, 0, 0)) abort();
+   double_list_model_delete(&model);
+   return 0;
+}
+
+#ifdef DOUBLE_LIST_FUZZ_STANDALONE
+/*******************************************************************************
+* main: Lser indata frn stdin och genomfr operationerna via
+*       LLVMFuzzerTestOneInput, vilket mjliggr fuzzning via AFL samt
+*       uppspelning av sparade indata utan libFuzzer.
+*******************************************************************************/
+int main(void)
+{
+   static uint8_t data[1 << 20];
+   const size_t size = fread(data, 1, sizeof(data), stdin);
+   return LLVMFuzzerTestOneInput(data, size);
+}
+#endif /* DOUBLE_LIST_FUZZ_STANDALONE */
\ No newline at end of file
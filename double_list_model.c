@@ -0,0 +1,594 @@
+/*******************************************************************************
+* double_list_model.c: Innehller funktioner fr differentiell testning av
+*                      dubbellnkade listor mot en referensmodell i form av
+*                      en array via strukten double_list_model.
+*******************************************************************************/
+#include "double_list_model.h"
+#include "double_reclaimer.h"
+#include "double_view.h"
+#include <math.h>
+#include <string.h>
+
+/* Statiska funktioner: */
+static double double_list_model_value(const unsigned char val);
+static int double_list_model_same(const double x,
+                                  const double y);
+static int double_list_model_compare(const struct double_list_model* self,
+                                     const struct double_list* list);
+static void double_list_model_insert(struct double_list_model* self,
+                                     const size_t index,
+                                     const double val);
+static void double_list_model_erase(struct double_list_model* self,
+                                    const size_t index);
+static size_t double_list_model_position(const struct double_list* list,
+                                         const struct double_node* node);
+static int double_list_model_sync(struct double_list_model* self);
+static int double_list_model_positive(const double val,
+                                      void* context);
+static double double_list_model_square(const double val,
+                                       void* context);
+static double double_list_model_add(const double x,
+                                    const double y,
+                                    void* context);
+
+/*******************************************************************************
+* double_list_model_new: Initierar en tom referensmodell med tillhrande
+*                        lnkad lista, ndringslogg och kopia. Vid misslyckad
+*                        allokering returneras 1, annars 0.
+*
+*                        - self: Pekare till modellen som skall initieras.
+*******************************************************************************/
+int double_list_model_new(struct double_list_model* self)
+{
+   double_list_new(&self->list);
+   double_list_new(&self->replica);
+   double_journal_new(&self->journal);
+   double_journal_new(&self->incoming);
+   double_list_journal_attach(&self->list, &self->journal);
+
+   self->size = 0;
+   self->data = (double*)malloc(sizeof(double) * DOUBLE_LIST_MODEL_MAX_SIZE);
+   self->stream = tmpfile();
+
+   if (!self->data || !self->stream)
+   {
+      double_list_model_delete(self);
+      return 1;
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+* double_list_model_delete: Frigr minne allokerat fr angiven referensmodell.
+*
+*                           - self: Pekare till modellen.
+*******************************************************************************/
+void double_list_model_delete(struct double_list_model* self)
+{
+   double_list_journal_attach(&self->list, 0);
+   double_list_delete(&self->list);
+   double_list_delete(&self->replica);
+   double_journal_delete(&self->journal);
+   double_journal_delete(&self->incoming);
+   if (self->stream) fclose(self->stream);
+   free(self->data);
+
+   self->stream = 0;
+   self->data = 0;
+   self->size = 0;
+   return;
+}
+
+/*******************************************************************************
+* double_list_model_step: Genomfr angiven operation bde p den lnkade
+*                         listan och p modellen, varefter listan jmfrs mot
+*                         modellen. Operationer som skulle gra modellen
+*                         strre n DOUBLE_LIST_MODEL_MAX_SIZE hoppas ver.
+*                         Ifall listan avviker frn modellen returneras 1,
+*                         annars 0.
+*
+*                         - self: Pekare till modellen.
+*                         - op  : Operation (reduceras modulo
+*                                 DOUBLE_LIST_MODEL_NUM_OPS).
+*                         - arg : Argument, exempelvis ett index eller antal.
+*                         - val : Index till det flyttal som skall anvndas.
+*******************************************************************************/
+int double_list_model_step(struct double_list_model* self,
+                           const unsigned char op,
+                           const size_t arg,
+                           const unsigned char val)
+{
+   struct double_list* list = &self->list;
+   const double num = double_list_model_value(val);
+   const size_t size = self->size;
+   const int full = size >= DOUBLE_LIST_MODEL_MAX_SIZE;
+
+   switch (op % DOUBLE_LIST_MODEL_NUM_OPS)
+   {
+      case DOUBLE_LIST_MODEL_PUSH_FRONT: /* double_list_push_front */
+      {
+         if (full) break;
+         if (double_list_push_front(list, num)) return 1;
+         double_list_model_insert(self, 0, num);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_PUSH_BACK: /* double_list_push_back */
+      {
+         if (full) break;
+         if (double_list_push_back(list, num)) return 1;
+         double_list_model_insert(self, size, num);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_POP_FRONT: /* double_list_pop_front */
+      {
+         double_list_pop_front(list);
+         if (size) double_list_model_erase(self, 0);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_POP_BACK: /* double_list_pop_back */
+      {
+         double_list_pop_back(list);
+         if (size) double_list_model_erase(self, size - 1);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_INSERT_AT_INDEX: /* double_list_insert_at_index */
+      {
+         const size_t index = arg % (size + 2);
+         if (full) break;
+
+         if (index > size)
+         {
+            if (!double_list_insert_at_index(list, index, num)) return 1;
+         }
+         else
+         {
+            if (double_list_insert_at_index(list, index, num)) return 1;
+            double_list_model_insert(self, index, num);
+         }
+         break;
+      }
+      case DOUBLE_LIST_MODEL_INSERT_AT_ADDRESS: /* double_list_insert_at_address */
+      {
+         const size_t index = arg % (size + 1);
+         struct double_node* node = index < size ? double_list_node_at(list, index) :
+                                                   double_list_end(list);
+         if (full) break;
+         if (double_list_insert_at_address(list, node, num)) return 1;
+         double_list_model_insert(self, index, num);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_REMOVE_AT_INDEX: /* double_list_remove_at_index */
+      {
+         const size_t index = arg % (size + 2);
+
+         if (index >= size)
+         {
+            if (!double_list_remove_at_index(list, index)) return 1;
+         }
+         else
+         {
+            if (double_list_remove_at_index(list, index)) return 1;
+            double_list_model_erase(self, index);
+         }
+         break;
+      }
+      case DOUBLE_LIST_MODEL_REMOVE_AT_ADDRESS: /* double_list_remove_at_address */
+      {
+         const size_t index = size ? arg % size : 0;
+         if (!size) break;
+         double_list_remove_at_address(list, double_list_node_at(list, index));
+         double_list_model_erase(self, index);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_ASSIGN_AT_INDEX: /* double_list_assign_at_index */
+      {
+         const size_t index = arg % (size + 1);
+         double_list_assign_at_index(list, index, num);
+         if (index < size) self->data[index] = num;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_ASSIGN_AT_ADDRESS: /* double_list_assign_at_address */
+      {
+         const size_t index = size ? arg % size : 0;
+         if (!size) break;
+         double_list_assign_at_address(list, double_list_node_at(list, index), num);
+         self->data[index] = num;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_AT_INDEX: /* double_list_at_index */
+      {
+         const size_t index = arg % (size + 1);
+         const double expected = index < size ? self->data[index] : 0;
+         if (!double_list_model_same(double_list_at_index(list, index), expected)) return 1;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_AT_ADDRESS: /* double_list_node_at samt double_list_at_address */
+      {
+         const size_t index = arg % (size + 1);
+         const struct double_node* node = double_list_node_at(list, index);
+
+         if (index >= size)
+         {
+            if (node) return 1;
+         }
+         else if (!node || !double_list_model_same(double_list_at_address(list, node),
+                                                   self->data[index]))
+         {
+            return 1;
+         }
+         break;
+      }
+      case DOUBLE_LIST_MODEL_RESIZE: /* double_list_resize */
+      {
+         const size_t new_size = arg % (DOUBLE_LIST_MODEL_MAX_SIZE / 2 + 1);
+         if (double_list_resize(list, new_size)) return 1;
+         while (self->size < new_size) double_list_model_insert(self, self->size, 0);
+         self->size = new_size;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_COPY: /* double_list_copy */
+      {
+         struct double_list copy;
+         double_list_new(&copy);
+         if (double_list_copy(&copy, list) || double_list_model_compare(self, &copy)) return 1;
+         if (double_list_copy(list, &copy)) return 1;
+         double_list_delete(&copy);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_JOIN: /* double_list_join */
+      {
+         if (2 * size > DOUBLE_LIST_MODEL_MAX_SIZE) break;
+         if (double_list_join(list, list)) return 1;
+         memcpy(self->data + size, self->data, sizeof(double) * size);
+         self->size = 2 * size;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_MOVE: /* double_list_move */
+      {
+         struct double_list other;
+         double_list_new(&other);
+         double_list_move(&other, list);
+         if (list->size || double_list_model_compare(self, &other)) return 1;
+         double_list_move(list, &other);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_PTR_NEW: /* double_list_ptr_new samt double_list_ptr_delete */
+      {
+         const size_t count = arg % 16;
+         struct double_list* other = 0;
+         if (size + count > DOUBLE_LIST_MODEL_MAX_SIZE) break;
+
+         other = double_list_ptr_new(count, num);
+         if (!other || other->size != count) return 1;
+         if (double_list_join(list, other)) return 1;
+         double_list_ptr_delete(&other);
+         if (other) return 1;
+
+         for (size_t i = 0; i < count; ++i) double_list_model_insert(self, self->size, num);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_CLEAR: /* double_list_clear */
+      {
+         double_list_clear(list);
+         self->size = 0;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_DELETE: /* double_list_delete */
+      {
+         double_list_delete(list);
+         if (list->index) return 1;
+         self->size = 0;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_PRINT: /* double_list_print */
+      {
+         rewind(self->stream);
+         double_list_print(list, self->stream);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_INDEX_ENABLE: /* double_list_index_enable */
+      {
+         if (double_list_index_enable(list)) return 1;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_INDEX_DISABLE: /* double_list_index_disable */
+      {
+         double_list_index_disable(list);
+         if (list->index) return 1;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_FIND: /* double_list_find samt double_list_contains */
+      {
+         const struct double_node* node = double_list_find(list, num);
+         int expected = 0;
+
+         for (size_t i = 0; i < size && !expected; ++i)
+         {
+            expected = double_index_equal(self->data[i], num);
+         }
+
+         if (expected != double_list_contains(list, num)) return 1;
+         if (expected != (node != 0)) return 1;
+         if (node && !double_index_equal(node->data, num)) return 1;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_REMOVE_VALUE: /* double_list_remove_value */
+      {
+         const struct double_node* node = double_list_find(list, num);
+         const size_t index = node ? double_list_model_position(list, node) : 0;
+
+         if (double_list_remove_value(list, num) != !node) return 1;
+         if (node) double_list_model_erase(self, index);
+         break;
+      }
+      case DOUBLE_LIST_MODEL_JOURNAL_SYNC: /* double_journal_compact, _write, _read samt _apply */
+      {
+         if (double_list_model_sync(self)) return 1;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_JOURNAL_ATTACH: /* double_list_journal_attach (ny gonblicksbild) */
+      {
+         double_list_journal_attach(list, 0);
+         double_list_journal_attach(list, &self->journal);
+         if (double_list_model_sync(self)) return 1;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_VIEW_PIPELINE: /* double_view_skip, _take, _filter, _map samt _sum */
+      {
+         struct double_view view;
+         const size_t skip = arg % 8;
+         const size_t take = (arg / 8) % 64;
+         double expected = 0;
+         size_t count = 0;
+
+         double_view_new(&view, list);
+         if (double_view_skip(&view, skip) || double_view_take(&view, take) ||
+             double_view_filter(&view, &double_list_model_positive, 0) ||
+             double_view_map(&view, &double_list_model_square, 0)) return 1;
+
+         for (size_t i = skip; i < size && i < skip + take; ++i)
+         {
+            if (self->data[i] > 0)
+            {
+               expected += self->data[i] * self->data[i];
+               count++;
+            }
+         }
+
+         if (!double_list_model_same(double_view_sum(&view), expected)) return 1;
+         double_view_reset(&view);
+         if (double_view_count(&view) != count) return 1;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_VIEW_ZIP: /* double_view_zip, _reduce samt _to_array */
+      {
+         struct double_view view;
+         double* data = (double*)malloc(sizeof(double) * (size + 1));
+         double expected = 0;
+         size_t count = 0;
+         if (!data) return 1;
+
+         double_view_new(&view, list);
+         if (double_view_zip(&view, list, &double_list_model_add, 0)) return 1;
+         count = double_view_to_array(&view, data, size + 1);
+
+         for (size_t i = 0; i < size; ++i)
+         {
+            expected += self->data[i] + self->data[i];
+            if (i < count && !double_list_model_same(data[i], self->data[i] + self->data[i])) count = 0;
+         }
+
+         free(data);
+         if (count != size) return 1;
+         double_view_reset(&view);
+
+         if (!double_list_model_same(double_view_reduce(&view, 0, &double_list_model_add, 0),
+                                     expected)) return 1;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_VIEW_COLLECT: /* double_view_collect till den lista som vyn lser */
+      {
+         struct double_view view;
+         const size_t take = arg % 8;
+         const size_t count = take < size ? take : size;
+         if (size + count > DOUBLE_LIST_MODEL_MAX_SIZE) break;
+
+         double_view_new(&view, list);
+         if (double_view_take(&view, take) || double_view_collect(&view, list)) return 1;
+         memcpy(self->data + size, self->data, sizeof(double) * count);
+         self->size = size + count;
+         break;
+      }
+      case DOUBLE_LIST_MODEL_RECLAIMER_FLUSH: /* double_reclaimer_flush samt _pending */
+      {
+         double_reclaimer_flush();
+         if (double_reclaimer_pending()) return 1;
+         break;
+      }
+   }
+
+   return double_list_model_check(self);
+}
+
+/*******************************************************************************
+* double_list_model_check: Kontrollerar att den lnkade listan r konsistent
+*                          och verensstmmer med modellen. Ifall listan
+*                          avviker returneras 1, annars 0.
+*
+*                          - self: Pekare till modellen.
+*******************************************************************************/
+int double_list_model_check(const struct double_list_model* self)
+{
+   return double_list_model_compare(self, &self->list);
+}
+
+/*******************************************************************************
+* double_list_model_value: Returnerar flyttalet som motsvarar angivet index.
+*                          Urvalet r litet fr att ge mnga dubbletter och
+*                          innehller +0, -0 samt NaN.
+*
+*                          - val: Index till flyttalet.
+*******************************************************************************/
+static double double_list_model_value(const unsigned char val)
+{
+   static const double values[] = { 0.0, -0.0, 1.0, -1.0, 0.5, 2.0, 3.0, 1e300, -7.0 };
+   const size_t num_values = sizeof(values) / sizeof(values[0]);
+   if (val % (num_values + 1) == num_values) return NAN;
+   return values[val % (num_values + 1)];
+}
+
+/*******************************************************************************
+* double_list_model_same: Indikerar ifall tv flyttal r identiska, det vill
+*                         sga har samma bitmnster eller bda r NaN.
+*
+*                         - x: Det frsta flyttalet.
+*                         - y: Det andra flyttalet.
+*******************************************************************************/
+static int double_list_model_same(const double x,
+                                  const double y)
+{
+   return !memcmp(&x, &y, sizeof(double)) || (x != x && y != y);
+}
+
+/*******************************************************************************
+* double_list_model_compare: Kontrollerar att angiven lnkad lista r
+*                            konsistent via double_list_verify samt att dess
+*                            innehll, genomlpt bde framt och bakt,
+*                            verensstmmer med modellen. Ifall listan
+*                            avviker returneras 1, annars 0.
+*
+*                            - self: Pekare till modellen.
+*                            - list: Pekare till den lnkade listan.
+*******************************************************************************/
+static int double_list_model_compare(const struct double_list_model* self,
+                                     const struct double_list* list)
+{
+   size_t index = 0;
+
+   if (double_list_verify(list) || list->size != self->size) return 1;
+
+   for (const struct double_node* i = double_list_begin(list); i != double_list_end(list); i = i->next)
+   {
+      if (index >= self->size || !double_list_model_same(i->data, self->data[index++])) return 1;
+   }
+
+   for (const struct double_node* i = list->last; i; i = i->previous)
+   {
+      if (!index || !double_list_model_same(i->data, self->data[--index])) return 1;
+   }
+
+   return index != 0;
+}
+
+/*******************************************************************************
+* double_list_model_insert: Placerar angivet flyttal p angivet index i
+*                           modellen.
+*
+*                           - self : Pekare till modellen.
+*                           - index: Index dr flyttalet skall placeras.
+*                           - val  : Flyttalet som skall placeras.
+*******************************************************************************/
+static void double_list_model_insert(struct double_list_model* self,
+                                     const size_t index,
+                                     const double val)
+{
+   memmove(self->data + index + 1, self->data + index, sizeof(double) * (self->size - index));
+   self->data[index] = val;
+   self->size++;
+   return;
+}
+
+/*******************************************************************************
+* double_list_model_erase: Tar bort flyttalet p angivet index ur modellen.
+*
+*                          - self : Pekare till modellen.
+*                          - index: Index fr flyttalet som skall tas bort.
+*******************************************************************************/
+static void double_list_model_erase(struct double_list_model* self,
+                                    const size_t index)
+{
+   memmove(self->data + index, self->data + index + 1, sizeof(double) * (self->size - index - 1));
+   self->size--;
+   return;
+}
+
+/*******************************************************************************
+* double_list_model_position: Returnerar index fr angiven nod i angiven
+*                             lnkad lista.
+*
+*                             - list: Pekare till den lnkade listan.
+*                             - node: Pekare till noden.
+*******************************************************************************/
+static size_t double_list_model_position(const struct double_list* list,
+                                         const struct double_node* node)
+{
+   size_t index = 0;
+   for (const struct double_node* i = list->first; i != node; i = i->next) index++;
+   return index;
+}
+
+/*******************************************************************************
+* double_list_model_sync: Komprimerar listans ndringslogg, skickar den via
+*                         den temporra filen, spelar upp den p kopian och
+*                         kontrollerar att kopian verensstmmer med modellen.
+*                         Ifall kopian avviker returneras 1, annars 0.
+*
+*                         - self: Pekare till modellen.
+*******************************************************************************/
+static int double_list_model_sync(struct double_list_model* self)
+{
+   if (self->journal.error || double_journal_compact(&self->journal)) return 1;
+
+   rewind(self->stream);
+   if (double_journal_write(&self->journal, self->stream)) return 1;
+   rewind(self->stream);
+   if (double_journal_read(&self->incoming, self->stream)) return 1;
+   if (double_journal_apply(&self->incoming, &self->replica)) return 1;
+
+   double_journal_clear(&self->journal);
+   double_journal_clear(&self->incoming);
+   return double_list_model_compare(self, &self->replica);
+}
+
+/*******************************************************************************
+* double_list_model_positive: Filtervillkor som slpper igenom positiva
+*                             flyttal.
+*
+*                             - val    : Flyttalet som testas.
+*                             - context: Anvnds ej.
+*******************************************************************************/
+static int double_list_model_positive(const double val,
+                                      void* context)
+{
+   (void)context;
+   return val > 0;
+}
+
+/*******************************************************************************
+* double_list_model_square: Returnerar kvadraten av angivet flyttal.
+*
+*                           - val    : Flyttalet som skall kvadreras.
+*                           - context: Anvnds ej.
+*******************************************************************************/
+static double double_list_model_square(const double val,
+                                       void* context)
+{
+   (void)context;
+   return val * val;
+}
+
+/*******************************************************************************
+* double_list_model_add: Returnerar summan av tv flyttal.
+*
+*                        - x      : Det frsta flyttalet.
+*                        - y      : Det andra flyttalet.
+*                        - context: Anvnds ej.
+*******************************************************************************/
+static double double_list_model_add(const double x,
+                                    const double y,
+                                    void* context)
+{
+   (void)context;
+   return x + y;
+}
\ No newline at end of file
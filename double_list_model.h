@@ -0,0 +1,77 @@
+/*******************************************************************************
+* double_list_model.h: Innehller en referensmodell fr differentiell testning
+*                      av dubbellnkade listor av strukten double_list. Varje
+*                      operation genomfrs bde p en lnkad lista och p en
+*                      enkel array, varefter listans lnkar (i bda
+*                      riktningar), storlek och innehll jmfrs mot arrayen.
+*                      Modellen anvnds av fuzzningsmlet double_list_fuzz.c
+*                      samt av det randomiserade testet double_list_test.c.
+*******************************************************************************/
+#ifndef DOUBLE_LIST_MODEL_H_
+#define DOUBLE_LIST_MODEL_H_
+
+/* Inkluderingsdirektiv: */
+#include "double_list.h"
+
+/* Makrodefinitioner (operationer, se double_list_model_step): */
+#define DOUBLE_LIST_MODEL_PUSH_FRONT 0        /* double_list_push_front. */
+#define DOUBLE_LIST_MODEL_PUSH_BACK 1         /* double_list_push_back. */
+#define DOUBLE_LIST_MODEL_POP_FRONT 2         /* double_list_pop_front. */
+#define DOUBLE_LIST_MODEL_POP_BACK 3          /* double_list_pop_back. */
+#define DOUBLE_LIST_MODEL_INSERT_AT_INDEX 4   /* double_list_insert_at_index. */
+#define DOUBLE_LIST_MODEL_INSERT_AT_ADDRESS 5 /* double_list_insert_at_address. */
+#define DOUBLE_LIST_MODEL_REMOVE_AT_INDEX 6   /* double_list_remove_at_index. */
+#define DOUBLE_LIST_MODEL_REMOVE_AT_ADDRESS 7 /* double_list_remove_at_address. */
+#define DOUBLE_LIST_MODEL_ASSIGN_AT_INDEX 8   /* double_list_assign_at_index. */
+#define DOUBLE_LIST_MODEL_ASSIGN_AT_ADDRESS 9 /* double_list_assign_at_address. */
+#define DOUBLE_LIST_MODEL_AT_INDEX 10         /* double_list_at_index. */
+#define DOUBLE_LIST_MODEL_AT_ADDRESS 11       /* double_list_node_at samt double_list_at_address. */
+#define DOUBLE_LIST_MODEL_RESIZE 12           /* double_list_resize. */
+#define DOUBLE_LIST_MODEL_COPY 13             /* double_list_copy. */
+#define DOUBLE_LIST_MODEL_JOIN 14             /* double_list_join. */
+#define DOUBLE_LIST_MODEL_MOVE 15             /* double_list_move. */
+#define DOUBLE_LIST_MODEL_PTR_NEW 16          /* double_list_ptr_new samt double_list_ptr_delete. */
+#define DOUBLE_LIST_MODEL_CLEAR 17            /* double_list_clear. */
+#define DOUBLE_LIST_MODEL_DELETE 18           /* double_list_delete. */
+#define DOUBLE_LIST_MODEL_PRINT 19            /* double_list_print. */
+#define DOUBLE_LIST_MODEL_INDEX_ENABLE 20     /* double_list_index_enable. */
+#define DOUBLE_LIST_MODEL_INDEX_DISABLE 21    /* double_list_index_disable. */
+#define DOUBLE_LIST_MODEL_FIND 22             /* double_list_find samt double_list_contains. */
+#define DOUBLE_LIST_MODEL_REMOVE_VALUE 23     /* double_list_remove_value. */
+#define DOUBLE_LIST_MODEL_JOURNAL_SYNC 24     /* Synkronisering via ndringsloggen. */
+#define DOUBLE_LIST_MODEL_JOURNAL_ATTACH 25   /* double_list_journal_attach. */
+#define DOUBLE_LIST_MODEL_VIEW_PIPELINE 26    /* double_view_skip, _take, _filter, _map samt _sum. */
+#define DOUBLE_LIST_MODEL_VIEW_ZIP 27         /* double_view_zip, _reduce samt _to_array. */
+#define DOUBLE_LIST_MODEL_VIEW_COLLECT 28     /* double_view_collect till den lista som vyn lser. */
+#define DOUBLE_LIST_MODEL_RECLAIMER_FLUSH 29  /* double_reclaimer_flush samt _pending. */
+#define DOUBLE_LIST_MODEL_NUM_OPS 30          /* Antalet olika operationer. */
+
+/* Makrodefinitioner: */
+#define DOUBLE_LIST_MODEL_MAX_SIZE 4096 /* Maximalt antal element i modellen. */
+
+/*******************************************************************************
+* double_list_model: Referensmodell bestende av den lnkade lista som testas,
+*                    en kopia som uppdateras enbart via listans ndringslogg
+*                    samt en array med det frvntade innehllet.
+*******************************************************************************/
+struct double_list_model
+{
+   struct double_list list;         /* Listan som testas. */
+   struct double_list replica;      /* Kopia som uppdateras via ndringsloggen. */
+   struct double_journal journal;   /* Listans ndringslogg. */
+   struct double_journal incoming;  /* ndringslogg inlst frn strmmen. */
+   FILE* stream;                    /* Temporr fil fr utskrift och loggar. */
+   double* data;                    /* Frvntat innehll. */
+   size_t size;                     /* Frvntad storlek. */
+};
+
+/* Externa funktioner: */
+int double_list_model_new(struct double_list_model* self);
+void double_list_model_delete(struct double_list_model* self);
+int double_list_model_step(struct double_list_model* self,
+                           const unsigned char op,
+                           const size_t arg,
+                           const unsigned char val);
+int double_list_model_check(const struct double_list_model* self);
+
+#endif /* DOUBLE_LIST_MODEL_H_ */
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*******************************************************************************
+* double_list_test.c: Lngvarigt randomiserat differentiellt test, dr
+*                     slumpmssiga operationer genomfrs bde p en
+*                     dubbellnkad lista och p referensmodellen i
+*                     double_list_model.c. Frdrjd frigrelse r aktiverad
+*                     under testet, s att ven bakgrundstrden testas.
+*
+*                     Kompilering:
+*                     gcc -std=c99 -g -O1 -fsanitize=address,undefined -I.
+*                         double_list_test.c double_list_model.c
+*                         double_list.c double_index.c double_journal.c
+*                         double_reclaimer.c double_view.c -lm -pthread
+*                         -o double_list_test
+*
+*                     Krning: ./double_list_test [antal operationer] [fr]
+*******************************************************************************/
+#include "double_list_model.h"
+#include "double_reclaimer.h"
+
+/*******************************************************************************
+* double_list_test_random: Returnerar nsta pseudoslumpmssiga tal via
+*                          xorshift64.
+*
+*                          - state: Pekare till generatorns tillstnd.
+*******************************************************************************/
+static unsigned long long double_list_test_random(unsigned long long* state)
+{
+   *state ^= *state << 13;
+   *state ^= *state >> 7;
+   *state ^= *state << 17;
+   return *state;
+}
+
+/*******************************************************************************
+* main: Genomfr angivet antal slumpmssiga operationer (1 000 000 som
+*       default) med angivet fr (1 som default). Operationer som tmmer
+*       listan vljs mer sllan n vriga, s att listan hinner vxa. Vid
+*       avvikelse skrivs operationens nummer ut och 1 returneras.
+*
+*       - argc: Antalet argument.
+*       - argv: Argumenten.
+*******************************************************************************/
+int main(int argc, char** argv)
+{
+   const unsigned long iterations = argc > 1 ? strtoul(argv[1], 0, 10) : 1000000;
+   unsigned long long state = argc > 2 ? strtoull(argv[2], 0, 10) : 1;
+   struct double_list_model model;
+   int result = 0;
+
+   if (!state) state = 1;
+   if (double_reclaimer_start(4 * DOUBLE_RECLAIMER_MIN_SIZE)) return 1;
+   if (double_list_model_new(&model)) return 1;
+
+   for (unsigned long i = 0; i < iterations && !result; ++i)
+   {
+      const unsigned long long r = double_list_test_random(&state);
+      unsigned char op = (unsigned char)(r % DOUBLE_LIST_MODEL_NUM_OPS);
+
+      if ((op == DOUBLE_LIST_MODEL_CLEAR || op == DOUBLE_LIST_MODEL_DELETE) &&
+          (r >> 40) % 16)
+      {
+         op = DOUBLE_LIST_MODEL_PUSH_BACK;
+      }
+
+      if (double_list_model_step(&model, op, (size_t)(r >> 8) & 0xffff,
+                                 (unsigned char)(r >> 24)))
+      {
+         fprintf(stderr, "Avvikelse vid operation %lu (kod %d)!\n", i, op);
+         result = 1;
+      }
+   }
+
+   double_list_model_delete(&model);
+   double_reclaimer_stop();
+   if (!result) printf("%lu operationer genomfrda utan avvikelse.\n", iterations);
+   return result;
+}
\ No newline at end of file
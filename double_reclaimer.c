@@ -0,0 +1,299 @@
+/*******************************************************************************
+* double_reclaimer.c: Innehller funktioner fr frdrjd frigrelse av noder
+*                     via en bakgrundstrd. verlmnade nodkedjor placeras i
+*                     en k, dr pekaren previous i varje kedjas frsta nod
+*                     anvnds fr att peka p nsta kedja i kn, vilket
+*                     medfr att verlmningen inte krver ngon allokering.
+*                     verlmnade hashindex placeras p motsvarande stt i
+*                     en separat k via pekaren next.
+*******************************************************************************/
+#include "double_reclaimer.h"
+#include "double_list.h"
+#include <pthread.h>
+
+/* Statiska variabler: */
+static pthread_mutex_t double_reclaimer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t double_reclaimer_work = PTHREAD_COND_INITIALIZER;  /* Ny kedja i kn. */
+static pthread_cond_t double_reclaimer_space = PTHREAD_COND_INITIALIZER; /* Noder frigjorda. */
+static pthread_t double_reclaimer_thread;
+static struct double_node* double_reclaimer_head = 0;        /* Frsta kedjan i kn. */
+static struct double_node* double_reclaimer_tail = 0;        /* Sista kedjan i kn. */
+static struct double_index* double_reclaimer_index_head = 0; /* Frsta indexet i kn. */
+static struct double_index* double_reclaimer_index_tail = 0; /* Sista indexet i kn. */
+static size_t double_reclaimer_size = 0;                     /* Ej frigjorda noder och indexposter. */
+static size_t double_reclaimer_max_size = 0;                 /* Maximalt antal ej frigjorda noder. */
+static int double_reclaimer_running = 0;                     /* Indikerar ifall trden krs. */
+static int double_reclaimer_stopping = 0;                    /* Indikerar ifall trden avslutas. */
+static int double_reclaimer_installed = 0;                   /* Indikerar ifall kroken installerats. */
+
+/* Statiska funktioner: */
+static void* double_reclaimer_run(void* arg);
+
+/*******************************************************************************
+* double_reclaimer_start: Startar bakgrundstrden fr frdrjd frigrelse.
+*                         Vid frsta start installeras double_reclaimer_submit
+*                         via double_list_set_free_hook, varefter
+*                         double_list_delete (och drmed ven
+*                         double_list_clear, double_list_copy samt
+*                         double_list_move) lmnar ver nodkedjor med minst
+*                         DOUBLE_RECLAIMER_MIN_SIZE noder till trden. Frsta
+*                         start mste drfr ske innan andra trdar anvnder
+*                         lnkade listor. Kroken ligger kvar efter stopp, d
+*                         double_reclaimer_submit returnerar 1 nr trden
+*                         inte krs.
+*                         Ifall en tidigare trd hller p att stoppas vntar
+*                         anroparen tills den har avslutats. Vid fel
+*                         returneras 1, annars 0.
+*
+*                         - max_pending: Maximalt antal noder som fr vnta
+*                                        p frigrelse samtidigt. Anropare
+*                                        som skulle verskrida grnsen vntar
+*                                        tills tillrckligt mnga noder har
+*                                        frigjorts. En kedja som ensam r
+*                                        strre n grnsen vntar tills kn
+*                                        r tom och lmnas sedan ver, s att
+*                                        hgst en sdan kedja vntar t gngen.
+*******************************************************************************/
+int double_reclaimer_start(const size_t max_pending)
+{
+   int result = 0;
+   pthread_mutex_lock(&double_reclaimer_mutex);
+
+   while (double_reclaimer_stopping)
+   {
+      pthread_cond_wait(&double_reclaimer_space, &double_reclaimer_mutex);
+   }
+
+   if (double_reclaimer_running)
+   {
+      result = 0;
+   }
+   else if (!max_pending || pthread_create(&double_reclaimer_thread, 0, &double_reclaimer_run, 0))
+   {
+      result = 1;
+   }
+   else
+   {
+      double_reclaimer_max_size = max_pending;
+      double_reclaimer_running = 1;
+
+      if (!double_reclaimer_installed)
+      {
+         double_list_set_free_hook(&double_reclaimer_submit);
+         double_reclaimer_installed = 1;
+      }
+   }
+
+   pthread_mutex_unlock(&double_reclaimer_mutex);
+   return result;
+}
+
+/*******************************************************************************
+* double_reclaimer_stop: Stoppar bakgrundstrden efter att samtliga verlmnade
+*                        noder har frigjorts. Drefter frigrs noder direkt av
+*                        anroparen.
+*******************************************************************************/
+void double_reclaimer_stop(void)
+{
+   pthread_t thread;
+   pthread_mutex_lock(&double_reclaimer_mutex);
+
+   if (!double_reclaimer_running)
+   {
+      pthread_mutex_unlock(&double_reclaimer_mutex);
+      return;
+   }
+
+   thread = double_reclaimer_thread;
+   double_reclaimer_running = 0;
+   double_reclaimer_stopping = 1;
+   pthread_cond_broadcast(&double_reclaimer_work);
+   pthread_cond_broadcast(&double_reclaimer_space);
+   pthread_mutex_unlock(&double_reclaimer_mutex);
+   pthread_join(thread, 0);
+
+   pthread_mutex_lock(&double_reclaimer_mutex);
+   double_reclaimer_stopping = 0;
+   pthread_cond_broadcast(&double_reclaimer_space);
+   pthread_mutex_unlock(&double_reclaimer_mutex);
+   return;
+}
+
+/*******************************************************************************
+* double_reclaimer_flush: Vntar tills samtliga verlmnade noder har frigjorts.
+*******************************************************************************/
+void double_reclaimer_flush(void)
+{
+   pthread_mutex_lock(&double_reclaimer_mutex);
+
+   while (double_reclaimer_size)
+   {
+      pthread_cond_wait(&double_reclaimer_space, &double_reclaimer_mutex);
+   }
+
+   pthread_mutex_unlock(&double_reclaimer_mutex);
+   return;
+}
+
+/*******************************************************************************
+* double_reclaimer_pending: Returnerar antalet verlmnade noder (samt poster
+*                           i verlmnade hashindex) som nnu inte har
+*                           frigjorts.
+*******************************************************************************/
+size_t double_reclaimer_pending(void)
+{
+   size_t size = 0;
+   pthread_mutex_lock(&double_reclaimer_mutex);
+   size = double_reclaimer_size;
+   pthread_mutex_unlock(&double_reclaimer_mutex);
+   return size;
+}
+
+/*******************************************************************************
+* double_reclaimer_submit: Lmnar ver en nodkedja till bakgrundstrden fr
+*                          frigrelse. Kedjan mste avslutas med en nod vars
+*                          pekare next r null. Ifall kedjan inte ryms inom
+*                          den maximala grnsen vntar anroparen tills kn
+*                          har tmts tillrckligt (fr en kedja som ensam
+*                          verskrider grnsen: tills kn r tom). Ifall
+*                          trden inte krs eller kedjan r mindre n
+*                          DOUBLE_RECLAIMER_MIN_SIZE noder returneras 1,
+*                          varvid anroparen sjlv ansvarar fr frigrelsen.
+*                          Annars returneras 0, varvid ven ett eventuellt
+*                          hashindex har lmnats ver och inte lngre fr
+*                          anvndas av anroparen. Indexets poster rknas in
+*                          i den maximala grnsen.
+*
+*                          - first: Pekare till kedjans frsta nod.
+*                          - size : Antalet noder i kedjan.
+*                          - index: Pekare till ett hashindex som skall
+*                                   frigras tillsammans med kedjan (eller
+*                                   null).
+*******************************************************************************/
+int double_reclaimer_submit(struct double_node* first,
+                            const size_t size,
+                            struct double_index* index)
+{
+   const size_t total = size + (index ? index->size : 0);
+   if (!first || size < DOUBLE_RECLAIMER_MIN_SIZE) return 1;
+   pthread_mutex_lock(&double_reclaimer_mutex);
+
+   while (double_reclaimer_running && double_reclaimer_size &&
+          double_reclaimer_size + total > double_reclaimer_max_size)
+   {
+      pthread_cond_wait(&double_reclaimer_space, &double_reclaimer_mutex);
+   }
+
+   if (!double_reclaimer_running)
+   {
+      pthread_mutex_unlock(&double_reclaimer_mutex);
+      return 1;
+   }
+
+   first->previous = 0;
+
+   if (double_reclaimer_tail)
+   {
+      double_reclaimer_tail->previous = first;
+   }
+   else
+   {
+      double_reclaimer_head = first;
+   }
+
+   double_reclaimer_tail = first;
+
+   if (index)
+   {
+      index->next = 0;
+
+      if (double_reclaimer_index_tail)
+      {
+         double_reclaimer_index_tail->next = index;
+      }
+      else
+      {
+         double_reclaimer_index_head = index;
+      }
+
+      double_reclaimer_index_tail = index;
+   }
+
+   double_reclaimer_size += total;
+   pthread_cond_signal(&double_reclaimer_work);
+   pthread_mutex_unlock(&double_reclaimer_mutex);
+   return 0;
+}
+
+/*******************************************************************************
+* double_reclaimer_run: Bakgrundstrdens huvudloop. Kedjor hmtas ur kn och
+*                       frigrs i omgngar om DOUBLE_RECLAIMER_BATCH_SIZE
+*                       noder, dr antalet ej frigjorda noder uppdateras efter
+*                       varje omgng s att vntande anropare kan fortstta.
+*                       Hashindex i kn frigrs fre kedjorna. Trden
+*                       avslutas nr den har stoppats och kerna r tomma.
+*
+*                       - arg: Anvnds ej.
+*******************************************************************************/
+static void* double_reclaimer_run(void* arg)
+{
+   (void)arg;
+   pthread_mutex_lock(&double_reclaimer_mutex);
+
+   while (1)
+   {
+      struct double_node* node = 0;
+      struct double_index* index = double_reclaimer_index_head;
+
+      while (!double_reclaimer_head && !index && double_reclaimer_running)
+      {
+         pthread_cond_wait(&double_reclaimer_work, &double_reclaimer_mutex);
+         index = double_reclaimer_index_head;
+      }
+
+      if (index)
+      {
+         const size_t count = index->size;
+         double_reclaimer_index_head = index->next;
+         if (!double_reclaimer_index_head) double_reclaimer_index_tail = 0;
+         pthread_mutex_unlock(&double_reclaimer_mutex);
+
+         double_index_ptr_delete(&index);
+
+         pthread_mutex_lock(&double_reclaimer_mutex);
+         double_reclaimer_size -= count;
+         pthread_cond_broadcast(&double_reclaimer_space);
+         continue;
+      }
+
+      if (!double_reclaimer_head) break;
+
+      node = double_reclaimer_head;
+      double_reclaimer_head = node->previous;
+      if (!double_reclaimer_head) double_reclaimer_tail = 0;
+      pthread_mutex_unlock(&double_reclaimer_mutex);
+
+      while (node)
+      {
+         size_t count = 0;
+
+         while (node && count < DOUBLE_RECLAIMER_BATCH_SIZE)
+         {
+            struct double_node* next = node->next;
+            free(node);
+            node = next;
+            count++;
+         }
+
+         pthread_mutex_lock(&double_reclaimer_mutex);
+         double_reclaimer_size -= count;
+         pthread_cond_broadcast(&double_reclaimer_space);
+         pthread_mutex_unlock(&double_reclaimer_mutex);
+      }
+
+      pthread_mutex_lock(&double_reclaimer_mutex);
+   }
+
+   pthread_mutex_unlock(&double_reclaimer_mutex);
+   return 0;
+}
\ No newline at end of file
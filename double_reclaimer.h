@@ -0,0 +1,32 @@
+/*******************************************************************************
+* double_reclaimer.h: Innehller funktionalitet fr frdrjd frigrelse av
+*                     noder i dubbellnkade listor av strukten double_list.
+*                     Nr frdrjd frigrelse r aktiverad lmnas stora
+*                     nodkedjor ver till en bakgrundstrd, s att radering
+*                     av en lista sker i konstant tid fr anroparen. Detta
+*                     gller ven listor med hashindex, vars tabeller lmnas
+*                     ver tillsammans med noderna.
+*******************************************************************************/
+#ifndef DOUBLE_RECLAIMER_H_
+#define DOUBLE_RECLAIMER_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+
+/* Makrodefinitioner: */
+#define DOUBLE_RECLAIMER_MIN_SIZE 1024   /* Minsta kedja som lmnas ver. */
+#define DOUBLE_RECLAIMER_BATCH_SIZE 4096 /* Noder som frigrs per omgng. */
+
+struct double_node;
+struct double_index;
+
+/* Externa funktioner: */
+int double_reclaimer_start(const size_t max_pending);
+void double_reclaimer_stop(void);
+void double_reclaimer_flush(void);
+size_t double_reclaimer_pending(void);
+int double_reclaimer_submit(struct double_node* first,
+                            const size_t size,
+                            struct double_index* index);
+
+#endif /* DOUBLE_RECLAIMER_H_ */
\ No newline at end of file
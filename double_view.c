@@ -0,0 +1,379 @@
+/*******************************************************************************
+* double_view.c: Innehller funktioner fr implementering av lata vyer ver
+*                dubbellnkade listor via strukten double_view.
+*******************************************************************************/
+#include "double_view.h"
+#include "double_list.h"
+
+/* Statiska funktioner: */
+static struct double_view_stage* double_view_add_stage(struct double_view* self,
+                                                       const int type);
+
+/*******************************************************************************
+* double_view_new: Initierar en vy utan steg ver samtliga element i angiven
+*                  lnkad lista.
+*
+*                  - self: Pekare till den vy som skall initieras.
+*                  - list: Pekare till den lnkade listan.
+*******************************************************************************/
+void double_view_new(struct double_view* self,
+                     const struct double_list* list)
+{
+   double_view_range(self, double_list_begin(list), double_list_end(list));
+   return;
+}
+
+/*******************************************************************************
+* double_view_range: Initierar en vy utan steg ver angivet intervall av
+*                    noder, exempelvis erhllet via double_list_begin och
+*                    double_list_end eller double_list_node_at.
+*
+*                    - self : Pekare till den vy som skall initieras.
+*                    - begin: Pekare till den frsta noden i intervallet.
+*                    - end  : Pekare till noden direkt efter intervallet.
+*******************************************************************************/
+void double_view_range(struct double_view* self,
+                       const struct double_node* begin,
+                       const struct double_node* end)
+{
+   self->begin = begin;
+   self->end = end;
+   self->cursor = begin;
+   self->num_stages = 0;
+   self->done = 0;
+   return;
+}
+
+/*******************************************************************************
+* double_view_filter: Lgger till ett steg som endast slpper igenom flyttal
+*                     fr vilka angivet villkor returnerar ett vrde skilt
+*                     frn noll. Ifall vyn redan har maximalt antal steg
+*                     returneras 1, annars 0.
+*
+*                     - self     : Pekare till vyn.
+*                     - predicate: Villkoret som testas fr varje flyttal.
+*                     - context  : Anvndardata som passeras till villkoret.
+*******************************************************************************/
+int double_view_filter(struct double_view* self,
+                       int (*predicate)(const double val, void* context),
+                       void* context)
+{
+   struct double_view_stage* stage = double_view_add_stage(self, DOUBLE_VIEW_FILTER);
+   if (!stage) return 1;
+   stage->predicate = predicate;
+   stage->context = context;
+   return 0;
+}
+
+/*******************************************************************************
+* double_view_map: Lgger till ett steg som erstter varje flyttal med
+*                  returvrdet frn angiven funktion. Ifall vyn redan har
+*                  maximalt antal steg returneras 1, annars 0.
+*
+*                  - self     : Pekare till vyn.
+*                  - transform: Funktionen som anropas fr varje flyttal.
+*                  - context  : Anvndardata som passeras till funktionen.
+*******************************************************************************/
+int double_view_map(struct double_view* self,
+                    double (*transform)(const double val, void* context),
+                    void* context)
+{
+   struct double_view_stage* stage = double_view_add_stage(self, DOUBLE_VIEW_MAP);
+   if (!stage) return 1;
+   stage->transform = transform;
+   stage->context = context;
+   return 0;
+}
+
+/*******************************************************************************
+* double_view_take: Lgger till ett steg som slpper igenom hgst angivet
+*                   antal flyttal. Nr grnsen har ntts avslutas genomgngen
+*                   av listan, s att resterande noder aldrig lses. Ifall vyn
+*                   redan har maximalt antal steg returneras 1, annars 0.
+*
+*                   - self : Pekare till vyn.
+*                   - count: Maximalt antal flyttal som slpps igenom.
+*******************************************************************************/
+int double_view_take(struct double_view* self,
+                     const size_t count)
+{
+   struct double_view_stage* stage = double_view_add_stage(self, DOUBLE_VIEW_TAKE);
+   if (!stage) return 1;
+   stage->count = count;
+   stage->remaining = count;
+   return 0;
+}
+
+/*******************************************************************************
+* double_view_skip: Lgger till ett steg som hoppar ver angivet antal flyttal.
+*                   Ifall vyn redan har maximalt antal steg returneras 1,
+*                   annars 0.
+*
+*                   - self : Pekare till vyn.
+*                   - count: Antalet flyttal som hoppas ver.
+*******************************************************************************/
+int double_view_skip(struct double_view* self,
+                     const size_t count)
+{
+   struct double_view_stage* stage = double_view_add_stage(self, DOUBLE_VIEW_SKIP);
+   if (!stage) return 1;
+   stage->count = count;
+   stage->remaining = count;
+   return 0;
+}
+
+/*******************************************************************************
+* double_view_zip: Lgger till ett steg som kombinerar varje flyttal med nsta
+*                  flyttal i angiven lista via angiven funktion. Vyn tar slut
+*                  nr ngon av listorna tar slut. Ifall vyn redan har
+*                  maximalt antal steg returneras 1, annars 0.
+*
+*                  - self   : Pekare till vyn.
+*                  - other  : Pekare till listan som flyttalen hmtas frn.
+*                  - combine: Funktionen som kombinerar tv flyttal.
+*                  - context: Anvndardata som passeras till funktionen.
+*******************************************************************************/
+int double_view_zip(struct double_view* self,
+                    const struct double_list* other,
+                    double (*combine)(const double x, const double y,
+                                      void* context),
+                    void* context)
+{
+   struct double_view_stage* stage = double_view_add_stage(self, DOUBLE_VIEW_ZIP);
+   if (!stage) return 1;
+   stage->combine = combine;
+   stage->context = context;
+   stage->begin = double_list_begin(other);
+   stage->cursor = stage->begin;
+   return 0;
+}
+
+/*******************************************************************************
+* double_view_reset: Startar om angiven vy frn intervallets brjan, s att
+*                    den kan konsumeras p nytt.
+*
+*                    - self: Pekare till vyn.
+*******************************************************************************/
+void double_view_reset(struct double_view* self)
+{
+   self->cursor = self->begin;
+   self->done = 0;
+
+   for (size_t i = 0; i < self->num_stages; ++i)
+   {
+      self->stages[i].remaining = self->stages[i].count;
+      self->stages[i].cursor = self->stages[i].begin;
+   }
+   return;
+}
+
+/*******************************************************************************
+* double_view_next: Hmtar nsta flyttal ur angiven vy. Noder lses i tur och
+*                   ordning och varje flyttal passerar samtliga steg innan
+*                   nsta nod lses. Ifall ett flyttal hmtades returneras 0,
+*                   annars 1 (vyn r slut).
+*
+*                   - self: Pekare till vyn.
+*                   - val : Pekare till variabeln som tilldelas flyttalet.
+*******************************************************************************/
+int double_view_next(struct double_view* self,
+                     double* val)
+{
+   while (!self->done && self->cursor && self->cursor != self->end)
+   {
+      double num = self->cursor->data;
+      int pass = 1;
+      self->cursor = self->cursor->next;
+
+      for (size_t i = 0; i < self->num_stages && pass; ++i)
+      {
+         struct double_view_stage* stage = &self->stages[i];
+
+         if (stage->type == DOUBLE_VIEW_FILTER)
+         {
+            pass = stage->predicate(num, stage->context) != 0;
+         }
+         else if (stage->type == DOUBLE_VIEW_MAP)
+         {
+            num = stage->transform(num, stage->context);
+         }
+         else if (stage->type == DOUBLE_VIEW_SKIP)
+         {
+            if (stage->remaining)
+            {
+               stage->remaining--;
+               pass = 0;
+            }
+         }
+         else if (stage->type == DOUBLE_VIEW_TAKE)
+         {
+            if (!stage->remaining)
+            {
+               self->done = 1;
+               pass = 0;
+            }
+            else if (!--stage->remaining)
+            {
+               self->done = 1;
+            }
+         }
+         else
+         {
+            if (!stage->cursor)
+            {
+               self->done = 1;
+               pass = 0;
+            }
+            else
+            {
+               num = stage->combine(num, stage->cursor->data, stage->context);
+               stage->cursor = stage->cursor->next;
+            }
+         }
+      }
+
+      if (pass)
+      {
+         *val = num;
+         return 0;
+      }
+   }
+
+   self->done = 1;
+   return 1;
+}
+
+/*******************************************************************************
+* double_view_reduce: Konsumerar angiven vy och returnerar resultatet av att
+*                     successivt kombinera ett startvrde med vyns flyttal.
+*
+*                     - self   : Pekare till vyn.
+*                     - init   : Startvrdet.
+*                     - combine: Funktionen som kombinerar resultatet hittills
+*                                med nsta flyttal.
+*                     - context: Anvndardata som passeras till funktionen.
+*******************************************************************************/
+double double_view_reduce(struct double_view* self,
+                          const double init,
+                          double (*combine)(const double x, const double y,
+                                            void* context),
+                          void* context)
+{
+   double result = init;
+   double num = 0;
+
+   while (!double_view_next(self, &num))
+   {
+      result = combine(result, num, context);
+   }
+
+   return result;
+}
+
+/*******************************************************************************
+* double_view_sum: Konsumerar angiven vy och returnerar summan av dess flyttal.
+*
+*                  - self: Pekare till vyn.
+*******************************************************************************/
+double double_view_sum(struct double_view* self)
+{
+   double sum = 0;
+   double num = 0;
+   while (!double_view_next(self, &num)) sum += num;
+   return sum;
+}
+
+/*******************************************************************************
+* double_view_count: Konsumerar angiven vy och returnerar antalet flyttal.
+*
+*                    - self: Pekare till vyn.
+*******************************************************************************/
+size_t double_view_count(struct double_view* self)
+{
+   size_t count = 0;
+   double num = 0;
+   while (!double_view_next(self, &num)) count++;
+   return count;
+}
+
+/*******************************************************************************
+* double_view_collect: Konsumerar angiven vy och lgger till dess flyttal sist
+*                      i angiven lnkad lista. Vyn lser endast noder som
+*                      fanns innan insamlingen brjade, vilket innebr att
+*                      en vy kan samlas in i samma lista som den lser
+*                      (listans innehll lggs d till en gng) utan att
+*                      tillagda noder blir ny indata. Vid misslyckad
+*                      minnesallokering returneras 1, annars 0.
+*
+*                      - self: Pekare till vyn.
+*                      - list: Pekare till den lnkade lista som flyttalen
+*                              skall lggas till i.
+*******************************************************************************/
+int double_view_collect(struct double_view* self,
+                        struct double_list* list)
+{
+   const struct double_node* end = self->end;
+   double num = 0;
+   int result = 0;
+
+   while (!double_view_next(self, &num))
+   {
+      if (double_list_push_back(list, num))
+      {
+         result = 1;
+         break;
+      }
+
+      if (!self->end) self->end = list->last;
+   }
+
+   self->end = end;
+   return result;
+}
+
+/*******************************************************************************
+* double_view_to_array: Hmtar flyttal ur angiven vy till en angiven
+*                       sammanhngande array, vilket endast krver en
+*                       allokering fr samtliga flyttal. Hmtningen avslutas
+*                       nr arrayen r full eller vyn r slut, varefter
+*                       antalet hmtade flyttal returneras.
+*
+*                       - self    : Pekare till vyn.
+*                       - data    : Pekare till arrayen.
+*                       - capacity: Antalet flyttal som arrayen rymmer.
+*******************************************************************************/
+size_t double_view_to_array(struct double_view* self,
+                            double* data,
+                            const size_t capacity)
+{
+   size_t count = 0;
+   while (count < capacity && !double_view_next(self, &data[count])) count++;
+   return count;
+}
+
+/*******************************************************************************
+* double_view_add_stage: Lgger till ett nollstllt steg av angiven typ sist
+*                        i angiven vy och returnerar dess adress. Ifall vyn
+*                        redan har maximalt antal steg returneras null.
+*
+*                        - self: Pekare till vyn.
+*                        - type: Stegets typ (DOUBLE_VIEW_*).
+*******************************************************************************/
+static struct double_view_stage* double_view_add_stage(struct double_view* self,
+                                                       const int type)
+{
+   struct double_view_stage* stage = 0;
+   if (self->num_stages >= DOUBLE_VIEW_MAX_STAGES) return 0;
+
+   stage = &self->stages[self->num_stages++];
+   stage->type = type;
+   stage->predicate = 0;
+   stage->transform = 0;
+   stage->combine = 0;
+   stage->context = 0;
+   stage->count = 0;
+   stage->remaining = 0;
+   stage->begin = 0;
+   stage->cursor = 0;
+   return stage;
+}
\ No newline at end of file
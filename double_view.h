@@ -0,0 +1,97 @@
+/*******************************************************************************
+* double_view.h: Innehller funktionalitet fr lata vyer ver dubbellnkade
+*                listor av strukten double_list. En vy bestr av en kedja
+*                av steg (filtrering, transformering, begrnsning samt
+*                sammanfogning med en annan lista) som genomfrs element fr
+*                element under en enda genomgng av listan, utan att ngra
+*                mellanliggande listor eller noder allokeras.
+*******************************************************************************/
+#ifndef DOUBLE_VIEW_H_
+#define DOUBLE_VIEW_H_
+
+/* Inkluderingsdirektiv: */
+#include <stdlib.h>
+
+/* Makrodefinitioner: */
+#define DOUBLE_VIEW_MAX_STAGES 8 /* Maximalt antal steg per vy. */
+#define DOUBLE_VIEW_FILTER 1     /* Slpper endast igenom matchande flyttal. */
+#define DOUBLE_VIEW_MAP 2        /* Transformerar varje flyttal. */
+#define DOUBLE_VIEW_TAKE 3       /* Slpper igenom ett begrnsat antal flyttal. */
+#define DOUBLE_VIEW_SKIP 4       /* Hoppar ver ett givet antal flyttal. */
+#define DOUBLE_VIEW_ZIP 5        /* Kombinerar med flyttal frn en annan lista. */
+
+struct double_list;
+struct double_node;
+
+/*******************************************************************************
+* double_view_stage: Ett steg i en vy av strukten double_view. Endast de
+*                    medlemmar som r relevanta fr stegets typ anvnds.
+*******************************************************************************/
+struct double_view_stage
+{
+   int type;                                                         /* Stegets typ. */
+   int (*predicate)(const double val, void* context);                /* Filtervillkor. */
+   double (*transform)(const double val, void* context);             /* Transformering. */
+   double (*combine)(const double x, const double y, void* context); /* Sammanfogning. */
+   void* context;                                                    /* Anvndardata. */
+   size_t count;                                                     /* Grns fr take/skip. */
+   size_t remaining;                                                 /* terstende antal fr take/skip. */
+   const struct double_node* begin;                                  /* Frsta noden fr zip. */
+   const struct double_node* cursor;                                 /* Aktuell nod fr zip. */
+};
+
+/*******************************************************************************
+* double_view: Implementering av en lat vy ver ett intervall av noder, dr
+*              begin pekar p den frsta noden och end p noden direkt efter
+*              den sista (null fr listans slut). Vyn konsumeras av
+*              double_view_next samt av funktionerna som reducerar eller
+*              materialiserar vyn, men kan startas om via double_view_reset.
+*******************************************************************************/
+struct double_view
+{
+   const struct double_node* begin;                         /* Frsta noden. */
+   const struct double_node* end;                           /* Noden efter den sista. */
+   const struct double_node* cursor;                        /* Nsta nod att lsa. */
+   struct double_view_stage stages[DOUBLE_VIEW_MAX_STAGES]; /* Vyns steg. */
+   size_t num_stages;                                       /* Antalet steg. */
+   int done;                                                /* Indikerar ifall vyn r slut. */
+};
+
+/* Externa funktioner: */
+void double_view_new(struct double_view* self,
+                     const struct double_list* list);
+void double_view_range(struct double_view* self,
+                       const struct double_node* begin,
+                       const struct double_node* end);
+int double_view_filter(struct double_view* self,
+                       int (*predicate)(const double val, void* context),
+                       void* context);
+int double_view_map(struct double_view* self,
+                    double (*transform)(const double val, void* context),
+                    void* context);
+int double_view_take(struct double_view* self,
+                     const size_t count);
+int double_view_skip(struct double_view* self,
+                     const size_t count);
+int double_view_zip(struct double_view* self,
+                    const struct double_list* other,
+                    double (*combine)(const double x, const double y,
+                                      void* context),
+                    void* context);
+void double_view_reset(struct double_view* self);
+int double_view_next(struct double_view* self,
+                     double* val);
+double double_view_reduce(struct double_view* self,
+                          const double init,
+                          double (*combine)(const double x, const double y,
+                                            void* context),
+                          void* context);
+double double_view_sum(struct double_view* self);
+size_t double_view_count(struct double_view* self);
+int double_view_collect(struct double_view* self,
+                        struct double_list* list);
+size_t double_view_to_array(struct double_view* self,
+                            double* data,
+                            const size_t capacity);
+
+#endif /* DOUBLE_VIEW_H_ */
\ No newline at end of file